@@ -0,0 +1,53 @@
+#ifndef AGGREGATES_H
+#define AGGREGATES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "employee.h"
+#include "range.h"
+
+// --- PER-DEPARTMENT AGGREGATES ---
+// Headcount, salary sum/min/max and an age histogram for every department,
+// kept up to date by the list helpers so a read costs O(#departments).
+// Min and max have to survive deletes, so each department also keeps its
+// salaries in a small RangeIndex. Departments are grouped by exact name.
+
+#define AGG_AGE_BUCKETS 11      // 0-9, 10-19, ... 90-99, 100+
+
+typedef struct {
+    int taken;                  // 0 = free slot
+    char name[50];
+    size_t count;               // 0 once every row left (slot stays for reuse)
+    long long salary_sum;
+    long long age_sum;
+    size_t age_buckets[AGG_AGE_BUCKETS];
+    RangeIndex salaries;        // (salary, id) for min / max
+} DeptStats;
+
+typedef struct {
+    int built;                  // 0 = not maintained; build before use
+    DeptStats *slots;           // Open addressing on the department name
+    size_t capacity;            // Power of two
+    size_t used;                // Named slots
+} DeptAggregates;
+
+void agg_init(DeptAggregates *a);
+void agg_free(DeptAggregates *a);
+
+// Aggregate every node of the list (0 on success, -1 if out of memory)
+int agg_build(DeptAggregates *a, const EmployeeList *list);
+
+// Keep a built index in step with the list (no-ops while not built).
+// An allocation failure drops it; the next read rebuilds it.
+void agg_add(DeptAggregates *a, const emp *node);
+void agg_remove(DeptAggregates *a, const emp *node);
+
+// Histogram bucket of an age
+int agg_age_bucket(int age);
+
+// Salary bounds of a department with rows (0 if it has none)
+int agg_salary_bounds(const DeptStats *d, int *min, int *max);
+
+#endif
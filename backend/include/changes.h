@@ -0,0 +1,58 @@
+#ifndef CHANGES_H
+#define CHANGES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "employee.h"
+
+// --- CHANGE RING ---
+// The last CHANGE_RING_SIZE changes to a table's list, for /changes?since=.
+// Every list change bumps Table.version by exactly one, so the change that
+// produced version v lives in slot v % CHANGE_RING_SIZE. The ring is only
+// allocated once a client asks for changes; before that (and once a client
+// falls more than a ring behind) the answer is "full resync".
+
+#define CHANGE_RING_SIZE 1024
+
+typedef enum {
+    CHANGE_INSERT = 1,          // 'row' went in at 'position'
+    CHANGE_DELETE = 2,          // Row 'row.id' left the list
+    CHANGE_REVERSE = 3          // The whole list was reversed
+} ChangeOp;
+
+typedef struct {
+    uint64_t version;           // Table version this change produced
+    int op;                     // ChangeOp
+    int position;               // CHANGE_INSERT only
+    EmployeeRecord row;         // Full row for CHANGE_INSERT, just the id for CHANGE_DELETE
+} Change;
+
+typedef struct {
+    Change *entries;            // CHANGE_RING_SIZE slots, NULL while not recording
+    uint64_t since;             // Oldest version a client can still sync from
+} ChangeRing;
+
+void change_ring_init(ChangeRing *r);
+void change_ring_free(ChangeRing *r);
+
+// Start recording at 'version' (0 on success or if already recording, -1 if out of memory)
+int change_ring_start(ChangeRing *r, uint64_t version);
+
+// Remember the change that produced 'version' (no-op while not recording)
+void change_ring_record(ChangeRing *r, uint64_t version, ChangeOp op, int position, const emp *node);
+
+// Forget the changes after 'version' (undone, never logged). 'reached' is the
+// highest version they were recorded at: their slots overwrote older entries,
+// which can't be replayed any more.
+void change_ring_rewind(ChangeRing *r, uint64_t version, uint64_t reached);
+
+// Can every change in (since, version] still be replayed?
+int change_ring_covers(const ChangeRing *r, uint64_t since, uint64_t version);
+
+// The change that produced 'version' (only valid when covered)
+const Change *change_ring_get(const ChangeRing *r, uint64_t version);
+
+#endif
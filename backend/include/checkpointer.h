@@ -0,0 +1,17 @@
+#ifndef CHECKPOINTER_H
+#define CHECKPOINTER_H
+
+#include "table.h"
+
+// --- BACKGROUND CHECKPOINTER ---
+// Every group_commit_ms the checkpointer fsyncs pending WAL writes
+// (group commit) and rewrites the snapshot of tables that are dirty
+// and either old (checkpoint_ms) or carrying a long log.
+
+// Start the checkpointer thread (call once, after load_server_config)
+int start_checkpointer(void);
+
+// Stop the thread and flush every dirty table (used on shutdown)
+void stop_checkpointer(void);
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef COLUMNS_H
+#define COLUMNS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "employee.h"
+
+// --- COLUMNAR VIEW (Struct of Arrays) ---
+// A copy of a table's rows in list order, one array per field, so a scan over
+// ages or salaries reads 4 bytes per row instead of a whole 120-byte node.
+// Strings are packed NUL-terminated into one text buffer. Each node remembers
+// its row (emp.col); removing it only sets 'removed' there, and scans skip
+// such rows until the next build compacts them away.
+typedef struct {
+    int valid;              // 0 = out of date with the list, rebuild before use
+    size_t rows;            // Including removed ones
+    size_t row_capacity;
+    size_t dead_rows;       // Rows with 'removed' set
+
+    int *id;
+    int *age;
+    int *salary;
+    uint32_t *name_off;     // Offsets into 'text'
+    uint32_t *dept_off;
+    uint8_t *name_len;
+    uint8_t *dept_len;
+    uint8_t *removed;       // 1 = row left the list, skip it
+
+    char *text;
+    size_t text_len;
+    size_t text_capacity;
+    size_t text_dead;       // Bytes of 'text' no row points at any more
+} ColumnStore;
+
+void columns_init(ColumnStore *cs);
+void columns_free(ColumnStore *cs);
+
+// Rebuild from the list, packed (0 on success, -1 if out of memory)
+int columns_build(ColumnStore *cs, const EmployeeList *list);
+
+// Add one row at the end (0 on success, -1 if out of memory)
+int columns_append(ColumnStore *cs, emp *node);
+
+// Copy in a node that was just linked into the list. It goes at the end if it
+// is the stored tail, or into the removed row right before its successor's
+// (an update put back in place). Anything else would have to shift rows:
+// returns -1 and the caller drops the store instead, as on out of memory.
+int columns_insert(ColumnStore *cs, emp *node);
+
+// Mark the row of a node leaving the list as removed. Once most rows are
+// removed (or most text is dead) the store marks itself invalid, so the next
+// build compacts.
+void columns_remove(ColumnStore *cs, const emp *node);
+
+// Field accessors for row 'i'
+static inline const char *columns_name(const ColumnStore *cs, size_t i)
+{
+    return cs->text + cs->name_off[i];
+}
+
+static inline const char *columns_department(const ColumnStore *cs, size_t i)
+{
+    return cs->text + cs->dept_off[i];
+}
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- DURABILITY MODES ---
+// When a logged mutation is forced to stable storage
+typedef enum {
+    DURABILITY_SYNC,        // fsync the WAL on every write before replying
+    DURABILITY_GROUP,       // Writes share one fsync every group_commit_ms
+    DURABILITY_ASYNC        // Never fsync the WAL; only snapshots are synced
+} DurabilityMode;
+
+// --- STARTUP SETTINGS ---
+// Read once from EMS_* environment variables before the server starts
+typedef struct {
+    DurabilityMode durability;  // EMS_DURABILITY = sync | group | async
+    int group_commit_ms;        // EMS_GROUP_COMMIT_MS (checkpointer tick)
+    int checkpoint_ms;          // EMS_CHECKPOINT_MS (max age of a dirty snapshot)
+    int trigram_index;          // EMS_TRIGRAM_INDEX = 1 | 0 (substring index for /search)
+    int workers;                // EMS_WORKERS (request threads, 0 = run handlers on the event loop)
+    int table_memory_mb;        // EMS_TABLE_MEMORY_MB (loaded tables above this are evicted, 0 = no limit)
+} ServerConfig;
+
+extern ServerConfig server_config;
+
+// Fill server_config from the environment (falls back to defaults)
+void load_server_config(void);
+
+// Printable name of a durability mode
+const char *durability_name(DurabilityMode mode);
+
+#endif
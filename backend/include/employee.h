@@ -19,6 +19,10 @@ typedef struct employee
   char name[50];
   char department[50];
   struct employee *next;
+  struct employee *prev;  // Lets a node found through the id index unlink itself in O(1)
+  unsigned int doc;       // Row number in the table's trigram index (trigram.h)
+  unsigned int col;       // Row of the table's columnar copy holding it (columns.h)
+  struct SkipTower *tower; // Express links of the positional index (skiplist.h), NULL on level 0 only
 } emp;
 
 // 2. Serialization Struct (For Disk - No Pointers!)
@@ -32,15 +36,22 @@ typedef struct
 } EmployeeRecord;
 
 // 3. The List Wrapper
+// head/tail/next/prev are the stored order. A reversed list is read tail to
+// head, so reversing only flips the flag; walk it with list_first/list_next.
 typedef struct
 {
   emp *head;
   emp *tail;
+  int reversed;           // 1 = logical order is tail -> head
 } EmployeeList;
 
 // --- FUNCTION DECLARATIONS ---
 void init_employee_list(EmployeeList *list);
-// Creates a node from JSON data
-emp *create_node_from_json(cJSON *json);
+
+// Logical order (what clients see), whichever way the list is stored
+emp *list_first(const EmployeeList *list);
+emp *list_last(const EmployeeList *list);
+emp *list_next(const EmployeeList *list, const emp *node);
+emp *list_prev(const EmployeeList *list, const emp *node);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,97 @@
+#ifndef FILTER_H
+#define FILTER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "search.h"
+
+// --- STRUCTURED FILTERS ---
+// /search?filter=department = "Sales" AND salary > 50000 AND age < 40
+// is parsed once per request into a flat program in postfix order: every
+// comparison pushes one bit and AND / OR / NOT combine the top of the stack,
+// so matching a row is a single loop with no recursion and no allocation.
+//
+//   expr       := term (OR term)*
+//   term       := factor (AND factor)*
+//   factor     := NOT factor | '(' expr ')' | field op value
+//   field      := id | name | age | department | salary
+//   op         := = | != | < | <= | > | >= | CONTAINS (text fields only)
+//
+// Numbers go with id / age / salary, "quoted" strings with name / department
+// (compared case-insensitively). Keywords and field names ignore case.
+
+#define FILTER_MAX_OPS 64       // Instructions per program (bounds the stack too)
+
+typedef enum {
+    FILTER_ID,
+    FILTER_NAME,
+    FILTER_AGE,
+    FILTER_DEPARTMENT,
+    FILTER_SALARY
+} FilterField;
+
+typedef enum {
+    FILTER_CMP,                 // Push (row.field cmp value)
+    FILTER_AND,
+    FILTER_OR,
+    FILTER_NOT
+} FilterOpKind;
+
+typedef enum {
+    CMP_EQ,
+    CMP_NE,
+    CMP_LT,
+    CMP_LE,
+    CMP_GT,
+    CMP_GE,
+    CMP_CONTAINS
+} FilterCmp;
+
+typedef struct {
+    int kind;                   // FilterOpKind
+    int field;                  // FilterField (FILTER_CMP only)
+    int cmp;                    // FilterCmp
+    int number;                 // Value for id / age / salary
+    SearchNeedle text;          // Value for name / department
+} FilterOp;
+
+typedef struct {
+    FilterOp ops[FILTER_MAX_OPS];
+    int count;
+} FilterProgram;
+
+// One row as the program sees it (filled from a node or the columnar copy)
+typedef struct {
+    int id;
+    int age;
+    int salary;
+    const char *name;
+    size_t name_len;
+    const char *department;
+    size_t dept_len;
+} FilterRow;
+
+// Comparisons every match has to satisfy (the top-level AND chain), so the
+// caller can fetch candidates from an index instead of scanning
+typedef struct {
+    int has_id;                 // id = 'id'
+    int id;
+    int has_age;                // age_min <= age <= age_max
+    int age_min, age_max;
+    int has_salary;             // salary_min <= salary <= salary_max
+    int salary_min, salary_max;
+} FilterPlan;
+
+// Parse and compile. Returns 0 on success, -1 with a message and the byte
+// offset it refers to otherwise.
+int filter_compile(const char *src, FilterProgram *prog, const char **error, size_t *error_pos);
+
+// Does the row satisfy the program?
+int filter_match(const FilterProgram *prog, const FilterRow *row);
+
+// Work out the index lookups the program allows
+void filter_plan(const FilterProgram *prog, FilterPlan *plan);
+
+#endif
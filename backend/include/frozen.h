@@ -0,0 +1,35 @@
+#ifndef FROZEN_H
+#define FROZEN_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "employee.h"
+
+// --- FROZEN ROWS ---
+// An immutable copy of a table's rows, in list order, at one version.
+// Full-table readers (/download_table, unpaged /show, /recursivereverse)
+// take one under a brief shared lock and encode from it with the table
+// unlocked, so a big export or a slow client never holds up writers.
+// The table keeps its latest copy: full reads of an unchanged table share
+// it, and a copy lives until its last reader lets go.
+
+typedef struct {
+    atomic_int refs;
+    uint64_t version;           // Table version the rows were copied at
+    size_t count;
+    EmployeeRecord rows[];      // List order
+} FrozenTable;
+
+// Copy the list's 'count' rows (refs = 1). NULL if out of memory.
+FrozenTable *frozen_build(const EmployeeList *list, size_t count, uint64_t version);
+
+void frozen_retain(FrozenTable *f);
+
+// Drop one reference; the last one frees the copy (NULL is ignored)
+void frozen_release(FrozenTable *f);
+
+#endif
@@ -35,6 +35,15 @@ void handle_showall(struct mg_connection *c, struct mg_http_message *hm);
 // --- 3. Searching ---
 void handle_search(struct mg_connection *c, struct mg_http_message *hm);
 
+// --- Range query on age / salary ---
+void handle_range(struct mg_connection *c, struct mg_http_message *hm);
+
+// --- Per-department aggregates ---
+void handle_aggregates(struct mg_connection *c, struct mg_http_message *hm);
+
+// --- Changes since a table version (delta sync) ---
+void handle_changes(struct mg_connection *c, struct mg_http_message *hm);
+
 // --- 4. Deletion ---
 void handle_delete(struct mg_connection *c, struct mg_http_message *hm);
 
@@ -47,6 +56,9 @@ void handle_recursive_reverse(struct mg_connection *c, struct mg_http_message *h
 // --- Handle Update ---
 void handle_update(struct mg_connection *c, struct mg_http_message *hm);
 
+// --- Batch of insert / update / delete ops, applied all or nothing ---
+void handle_batch(struct mg_connection *c, struct mg_http_message *hm);
+
 // --- 7. CSV Import ---
 void handle_import(struct mg_connection *c, struct mg_http_message *hm);
 
@@ -0,0 +1,40 @@
+#ifndef INDEX_H
+#define INDEX_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "employee.h"
+
+// --- ID INDEX ---
+// Open-addressing hash table (linear probing) from employee id to list node.
+// Each slot caches the id so probes don't have to touch the node itself.
+typedef struct {
+    emp *node;              // NULL = empty slot
+    int id;
+} IdSlot;
+
+typedef struct {
+    IdSlot *slots;
+    size_t capacity;        // Power of two (0 = not allocated yet)
+    size_t count;
+    int broken;             // Set if an allocation failed; callers fall back to scans
+} IdIndex;
+
+void id_index_init(IdIndex *idx);
+void id_index_free(IdIndex *idx);
+
+// Index every node of a list (first occurrence of an id wins)
+void id_index_build(IdIndex *idx, emp *head);
+
+// Lookup: returns the node with this id, or NULL
+emp *id_index_find(const IdIndex *idx, int id);
+
+// Insert or re-point the entry for node->id
+void id_index_put(IdIndex *idx, emp *node);
+
+// Drop the entry for this id (no-op if missing)
+void id_index_remove(IdIndex *idx, int id);
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef PAYLOAD_H
+#define PAYLOAD_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "employee.h"
+#include "cJSON.h"
+
+// --- EMPLOYEE PAYLOAD ---
+// The fields /insert and /update read from their JSON body:
+//   { table_id, owner_id, position, original_id, data: { id, name, age, department, salary } }
+// A single-pass tokenizer fills this struct straight from the request body
+// without allocating. Anything it doesn't handle (escapes in strings,
+// fractions, very long strings, deep nesting, broken JSON) is handed to cJSON
+// instead, so both paths produce the same result. Keys match
+// case-insensitively and the first occurrence wins, like cJSON_GetObjectItem.
+
+typedef enum {
+    FIELD_MISSING,
+    FIELD_NUMBER,
+    FIELD_STRING,
+    FIELD_OBJECT,
+    FIELD_OTHER             // true / false / null / array
+} FieldKind;
+
+typedef struct {
+    FieldKind kind;
+    int value;              // cJSON valueint: the number clamped to int, 0 for other kinds
+} PayloadField;
+
+typedef struct {
+    PayloadField table_id;
+    PayloadField owner_id;
+    PayloadField position;
+    PayloadField original_id;
+    FieldKind data;
+
+    // Members of "data"
+    PayloadField id, age, salary;
+    FieldKind name, department;
+    EmployeeRecord record;  // id/age/salary and the strings cut to 49 characters
+    size_t name_len;        // Full lengths, before cutting
+    size_t dept_len;
+    bool name_alpha;        // isOnlyAlphaSpaces() over the full strings
+    bool dept_alpha;
+} EmployeePayload;
+
+// 0 on success, -1 if the body is not valid JSON
+int parse_employee_payload(const char *body, size_t len, EmployeePayload *out);
+
+// Same fields from an object cJSON already parsed (e.g. one entry of a /batch body)
+void payload_from_json(const cJSON *json, EmployeePayload *out);
+
+#endif
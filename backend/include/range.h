@@ -0,0 +1,68 @@
+#ifndef RANGE_H
+#define RANGE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- RANGE INDEX ---
+// Sorted (key, id) pairs for one integer field, answering "min <= key <= max"
+// in O(log n + k). New entries go to a small sorted 'pending' run that is
+// merged into the main array once it grows past a fraction of it, so bulk
+// inserts don't memmove the whole array every time. Removing an entry of the
+// main array works the same way: it is listed in a small sorted 'removed' run
+// that readers skip, and dropped from 'main' in one pass once that run fills.
+typedef struct {
+    int key;
+    int id;
+} RangeEntry;
+
+typedef struct {
+    int built;              // 0 = not maintained; build before use
+
+    RangeEntry *main;       // Sorted by (key, id)
+    size_t main_len;
+    size_t main_capacity;
+
+    RangeEntry *pending;    // Sorted by (key, id), merged into 'main' when full
+    size_t pending_len;
+    size_t pending_capacity;
+
+    RangeEntry *removed;    // Sorted by (key, id); each one is still in 'main'
+    size_t removed_len;
+    size_t removed_capacity;
+} RangeIndex;
+
+// Walks the entries of one range in (key, id) order
+typedef struct {
+    const RangeIndex *index;
+    size_t main_pos;
+    size_t pending_pos;
+    size_t removed_pos;
+    int max;
+} RangeCursor;
+
+void range_index_init(RangeIndex *ri);
+void range_index_free(RangeIndex *ri);
+
+// Index 'count' pairs at once (0 on success, -1 if out of memory)
+int range_index_build(RangeIndex *ri, const RangeEntry *entries, size_t count);
+
+// Keep a built index in step with the table (no-ops while not built).
+// An allocation failure drops the index; the next query rebuilds it.
+void range_index_add(RangeIndex *ri, int key, int id);
+void range_index_remove(RangeIndex *ri, int key, int id);
+
+// Smallest and largest key (returns 0 and leaves them untouched when empty)
+int range_index_bounds(const RangeIndex *ri, int *min, int *max);
+
+// Entries with min <= key <= max, in O(log n) (how selective a range is)
+size_t range_index_count(const RangeIndex *ri, int min, int max);
+
+// Position a cursor on the first entry with key >= min
+void range_index_seek(const RangeIndex *ri, int min, int max, RangeCursor *cur);
+
+// Next id in range: returns 1 and sets *id, or 0 when the range is exhausted
+int range_cursor_next(RangeCursor *cur, int *id);
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- SEARCH KERNEL ---
+// A query is prepared once (lowercased, classified) and then matched against
+// every row. Text matching is case-insensitive and vectorized (AVX2 / SSE2 with
+// a scalar fallback); numbers are matched arithmetically instead of being
+// formatted to strings per row.
+
+#define NEEDLE_MAX 64
+
+typedef enum {
+    NUMERIC_NONE,           // Query can never appear inside "%d" output
+    NUMERIC_DIGITS,         // Only digits: match anywhere in the digits
+    NUMERIC_NEG_PREFIX      // '-' then digits: negative number starting with them
+} NumericKind;
+
+typedef struct {
+    char lower[NEEDLE_MAX]; // Lowercased query, NUL-terminated
+    size_t len;
+
+    NumericKind numeric;
+    int digit_count;        // Digits after an optional leading '-'
+    unsigned long long digit_value;
+    int leading_zero;       // First digit is '0'
+} SearchNeedle;
+
+// Prepare a query for matching (queries longer than NEEDLE_MAX-1 are truncated)
+void needle_prepare(SearchNeedle *n, const char *query);
+
+// Case-insensitive: does the needle occur in hay[0..hay_len)?
+int needle_in_text(const SearchNeedle *n, const char *hay, size_t hay_len);
+
+// Would strstr(sprintf("%d", value), query) succeed?
+int needle_in_number(const SearchNeedle *n, int value);
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef SKIPLIST_H
+#define SKIPLIST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "employee.h"
+
+// --- INDEXABLE SKIP LIST ---
+// Positional index over a table's employee list. Level 0 is the list itself
+// (emp next/prev); about one node in four also carries a tower of express
+// links for the levels above. Every express link stores its width (how many
+// rows it jumps), so "row at position k", "position of this row" and
+// insert/remove at any position take O(log n) instead of a walk.
+// Express links are doubly linked as well: that lets a node known only by
+// pointer (id index hit) be removed or ranked without searching from the head.
+// Positions here are in stored order (head = 0); table_row_at/table_row_rank
+// in utils.c turn them into what clients see when the list is reversed.
+
+#define SKIP_MAX_LEVEL 16       // Express levels; p = 1/4 covers ~4^16 rows
+
+typedef struct {
+    emp *next;
+    emp *prev;                  // Unused in the head's links
+    size_t width;               // Rows from here to 'next' (to one past the tail when next is NULL)
+} SkipLink;
+
+struct SkipTower {
+    union {
+        int levels;             // Express levels this node takes part in
+        struct SkipTower *next_free; // While waiting in the arena for reuse
+    };
+    SkipLink link[];            // link[i] is level i + 1
+};
+
+// --- TOWER ARENA ---
+// Towers are carved out of chunks the index owns instead of one calloc each.
+// A tower of L levels takes L + 1 SkipLink-sized slots (one for its header);
+// released towers wait on a free list per height, and the whole index is
+// freed chunk by chunk without visiting a row.
+#define TOWER_CHUNK_SLOTS 4096
+
+typedef struct TowerChunk {
+    struct TowerChunk *next;    // Older chunk
+    size_t used;                // Slots handed out so far (never shrinks)
+    SkipLink slots[TOWER_CHUNK_SLOTS];
+} TowerChunk;
+
+typedef struct {
+    TowerChunk *chunks;         // Newest first
+    struct SkipTower *free[SKIP_MAX_LEVEL + 1]; // Released towers, by height
+    size_t bytes;               // Chunk memory held
+} TowerArena;
+
+typedef struct {
+    SkipLink head[SKIP_MAX_LEVEL]; // Links out of the (virtual) head at each express level
+    int levels;                 // Express levels in use
+    size_t count;               // Rows in the list
+    uint32_t seed;              // xorshift state for tower heights
+    TowerArena towers;          // Where every tower of this list lives
+} SkipIndex;
+
+void skip_init(SkipIndex *s);
+
+// Free every tower at once (O(chunks)) and reset the index
+void skip_free(SkipIndex *s);
+
+// Give every node of a list that was linked by hand a tower and index it
+void skip_build(SkipIndex *s, EmployeeList *list);
+
+// Recompute all express links after the list was reordered or moved wholesale
+// (nodes keep their towers)
+void skip_relink(SkipIndex *s, EmployeeList *list);
+
+// Link 'node' so it ends up at position 'pos' (clamped to the row count, so
+// anything past the tail appends). Maintains list head/tail and level 0.
+void skip_insert(SkipIndex *s, EmployeeList *list, emp *node, size_t pos);
+
+// Unlink a node that is currently in the list (its tower is kept for reuse)
+void skip_remove(SkipIndex *s, EmployeeList *list, emp *node);
+
+// Row at position 'pos' (NULL past the tail)
+emp *skip_at(const SkipIndex *s, const EmployeeList *list, size_t pos);
+
+// Position of a node that is currently in the list
+size_t skip_rank(const SkipIndex *s, const emp *node);
+
+// Return the tower of a node that is being released to the arena
+void skip_release(SkipIndex *s, emp *node);
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef SLAB_H
+#define SLAB_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "employee.h"
+
+// --- NODE SLAB ALLOCATOR ---
+// Each table carves its emp nodes out of large slabs instead of one calloc per
+// row. Released nodes go on a free list for reuse, and the whole table is
+// freed slab by slab.
+#define SLAB_NODES 256
+
+typedef struct Slab {
+    struct Slab *next;      // Older slab
+    size_t capacity;        // Node slots in this slab
+    size_t used;            // Slots handed out so far (never shrinks)
+    emp nodes[];
+} Slab;
+
+typedef struct NodeAllocator {
+    Slab *slabs;            // Newest first
+    emp *free_list;         // Released nodes, chained through ->next
+    size_t slab_count;
+    size_t capacity;        // Node slots across all slabs
+    size_t live;            // Nodes currently handed out
+    size_t free_count;      // Nodes waiting on the free list
+    size_t churn;           // Allocs + releases since the last relayout
+} NodeAllocator;
+
+void node_alloc_init(NodeAllocator *a);
+
+// Free every slab at once (O(slabs), nodes need not be released first)
+void node_alloc_destroy(NodeAllocator *a);
+
+// One zeroed node (NULL if out of memory)
+emp *node_alloc(NodeAllocator *a);
+
+// 'count' zeroed nodes, contiguous in a single new slab (NULL if out of memory)
+emp *node_alloc_block(NodeAllocator *a, size_t count);
+
+// Return a node to the free list
+void node_release(NodeAllocator *a, emp *node);
+
+#endif
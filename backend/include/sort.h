@@ -0,0 +1,67 @@
+#ifndef SORT_H
+#define SORT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "employee.h"
+
+// --- SORTED VIEWS ---
+// /show?sort=field[,field]&order=asc|desc reads the rows through a
+// permutation: the table's nodes in sorted order. Building one sorts the
+// whole table, so each table keeps its last few by sort key. Every change
+// bumps the table version, and a permutation is only reused at the version
+// it was built for; paging through a sorted view then costs O(page).
+// compact_table moves the nodes, so it drops the cache. Readers pin the view
+// they stream from, so another reader's key never evicts it mid-response.
+
+#define SORT_MAX_FIELDS 5
+#define SORT_CACHE_SLOTS 4
+
+typedef enum {
+    SORT_ID,
+    SORT_NAME,                  // Case-insensitive
+    SORT_AGE,
+    SORT_DEPARTMENT,            // Case-insensitive
+    SORT_SALARY
+} SortField;
+
+typedef struct {
+    int fields[SORT_MAX_FIELDS]; // SortField, most significant first
+    int field_count;            // 0 = list order
+    int descending;             // Applies to every field
+} SortKey;
+
+typedef struct {
+    SortKey key;
+    uint64_t version;           // Table version the permutation was built at
+    emp **rows;                 // NULL = free slot
+    size_t count;
+    uint64_t last_used;         // Least recently used slot is replaced first
+    int pins;                   // Readers still streaming from it
+} SortedView;
+
+typedef struct {
+    SortedView slots[SORT_CACHE_SLOTS];
+    uint64_t clock;
+    uint64_t builds;            // Permutations sorted so far (the checkpointer re-measures memory)
+} SortCache;
+
+void sort_cache_init(SortCache *c);
+void sort_cache_free(SortCache *c);
+
+// Parse "salary,name" and "asc" / "desc" (NULL = asc).
+// Returns 0 on success, -1 for an unknown or repeated field, or a bad order.
+int sort_key_parse(const char *fields, const char *order, SortKey *key);
+
+// The list's 'count' rows in 'key' order (ties keep list order), reused while
+// the table is still at 'version'. The view comes back pinned; hand it to
+// sort_cache_release() when done. When every slot is pinned the view is a
+// private one. NULL if out of memory. Callers serialize get/release.
+SortedView *sort_cache_get(SortCache *c, const EmployeeList *list, size_t count,
+                           uint64_t version, const SortKey *key);
+void sort_cache_release(SortCache *c, SortedView *view);
+
+#endif
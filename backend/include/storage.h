@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 
 #include "employee.h" 
 
@@ -22,16 +23,87 @@ typedef struct {
     int is_active;          // 1 = Active, 0 = Deleted (Soft Delete)
 } TableMetadata;
 
-// Forward declaration
+// --- TABLE FILE FORMAT ---
+// bin/tables/<id>.bin = TableFileHeader followed by row_count EmployeeRecords.
+// The file is mmap'ed on load; headerless files from older builds (version 1)
+// are read the same way and rewritten in the current format. Version 2
+// headers end before 'data_version' and are still read (the table starts
+// at version 0); the next snapshot writes version 3.
+#define TABLE_FILE_MAGIC "LVTB"
+#define TABLE_FILE_VERSION 3
+#define TABLE_FILE_V2_HEADER_SIZE 24
+
+typedef struct {
+    char magic[4];          // TABLE_FILE_MAGIC
+    uint32_t version;       // TABLE_FILE_VERSION
+    uint32_t record_size;   // sizeof(EmployeeRecord) when written
+    uint32_t row_count;     // Records that follow the header
+    uint32_t checksum;      // CRC-32 of the record bytes
+    uint32_t reserved;      // Zero (keeps the records 8-byte aligned)
+    uint64_t data_version;  // Table.version when the snapshot was taken (v3+)
+} TableFileHeader;
+
+// --- WRITE-AHEAD LOG ---
+// Each mutation appends one fixed-size record to bin/tables/<id>.wal.
+// load_table_binary() replays the log over the last snapshot (<id>.bin),
+// up to the first record whose CRC doesn't match.
+typedef enum {
+    WAL_INSERT = 1,         // Insert 'data' at 'position'
+    WAL_DELETE = 2,         // Remove row 'target_id'
+    WAL_UPDATE = 3,         // Remove row 'target_id', insert 'data' at 'position'
+    WAL_REVERSE = 4,        // Reverse the whole list
+    WAL_BATCH = 5           // The next 'target_id' records are one batch: replayed all or not at all
+} WalOp;
+
+typedef struct {
+    int op;                 // WalOp
+    int target_id;          // Row being removed (DELETE / UPDATE)
+    int position;           // Insert position, -1 = append (INSERT / UPDATE)
+    EmployeeRecord data;    // New row (INSERT / UPDATE)
+    uint32_t crc;           // CRC-32 of the fields above (set by the log writer)
+} WalRecord;
+
+// Once the log holds this many records, the checkpointer folds it into a fresh snapshot
+#define WAL_CHECKPOINT_RECORDS 4096
+
+// Largest batch a single WAL_BATCH record may announce
+#define WAL_BATCH_MAX_RECORDS 65536
+
+// Forward declarations
 struct Table; 
+struct NodeAllocator;
 
 // --- HELPER FUNCTIONS ---
 EmployeeRecord node_to_record(emp *node);
-emp *record_to_node(EmployeeRecord record);
+emp *record_to_node(struct NodeAllocator *nodes, EmployeeRecord record);
 
 // --- CORE STORAGE FUNCTIONS ---
-void save_table_binary(struct Table *t);
-void load_table_binary(struct Table *t);
+// 0 on success, -1 if the snapshot is damaged (the table must not be served then)
+int load_table_binary(struct Table *t);
+
+// --- WAL FUNCTIONS (call while holding t->lock) ---
+// The wal_log_* calls return 0 once the change is in the log (or, if the log
+// can't take it, in a fresh snapshot); -1 if it is only in RAM.
+// Handlers answer 500 with this text then; the checkpointer keeps retrying the snapshot.
+#define WAL_ERROR_TEXT "Change could not be saved to disk"
+
+void wal_replay(struct Table *t);
+int wal_log_insert(struct Table *t, emp *node, int position);
+int wal_log_delete(struct Table *t, int target_id);
+int wal_log_update(struct Table *t, int original_id, emp *node, int position);
+int wal_log_reverse(struct Table *t);
+
+// Appends 'count' records as one batch with a single write (and a single fsync in sync mode)
+int wal_log_batch(struct Table *t, const WalRecord *records, int count);
+
+// Writes a crash-safe snapshot and empties the log. Returns 0 on success.
+int checkpoint_table(struct Table *t);
+
+// fsyncs log writes made since the last sync (group commit)
+void wal_sync(struct Table *t);
+
+// Closes the table's open log handle (used when unloading)
+void wal_close(struct Table *t);
 
 // --- USER AUTH FUNCTIONS ---
 // (Renamed for consistency)
@@ -45,6 +117,8 @@ TableMetadata* get_user_tables(int user_id, int *count);
 
 // Verify if a table belongs to a user (Security Check)
 int is_table_owner(int user_id, int table_id);
+// Same check for a caller already holding file_registry_lock
+int is_table_owner_locked(int user_id, int table_id);
 
 // Delete Table from memory
 int delete_table_permanently(int table_id, int owner_id);
@@ -0,0 +1,37 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mongoose.h"
+
+// --- STREAMING JSON RESPONSE ---
+// Writes a 200 response with chunked transfer encoding and encodes rows
+// straight into c->send: no cJSON tree, no intermediate string, no extra
+// copy by mg_http_reply. Chunks are framed in place (the size field is
+// reserved up front and patched when the chunk closes).
+typedef struct {
+    struct mg_connection *c;
+    size_t chunk_start;     // Offset of the open chunk's size field in c->send
+    int need_comma;         // A row was written since the last '[' / text
+    int failed;             // c->send could not grow; the connection is dropped at the end
+} JsonStream;
+
+// Status line + headers (plus 'extra_headers', each ending in \r\n), then opens the first chunk
+void json_stream_begin(JsonStream *js, struct mg_connection *c, const char *extra_headers);
+
+// Raw JSON punctuation or keys, e.g. "[" or "],\"next_cursor\":"
+void json_stream_text(JsonStream *js, const char *text);
+
+// Quoted, escaped string value (NULL writes null)
+void json_stream_string(JsonStream *js, const char *str);
+
+// One employee object, comma-separated from the previous row
+void json_stream_row(JsonStream *js, int id, const char *name, int age, const char *dept, int salary);
+
+// Closes the last chunk and terminates the body
+void json_stream_end(JsonStream *js);
+
+#endif
@@ -4,10 +4,22 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 #include <pthread.h>
+#include <stdatomic.h>
 
 #include "employee.h"
 #include "storage.h"
+#include "index.h"
+#include "slab.h"
+#include "columns.h"
+#include "trigram.h"
+#include "range.h"
+#include "skiplist.h"
+#include "aggregates.h"
+#include "changes.h"
+#include "sort.h"
+#include "frozen.h"
 
 // --- RUNTIME DATA STRUCTURE ---
 // Represents a Table currently loaded in RAM
@@ -17,21 +29,73 @@ typedef struct Table {
     char display_name[50];  // For display purposes
     
     EmployeeList employeelist; // The actual data
+    SkipIndex skip;         // Positional index over employeelist (row k, rank, insert at k in O(log n))
+    NodeAllocator nodes;    // Slabs every row node of this table lives in
+    IdIndex id_index;       // id -> node, kept in sync by the list helpers in utils.c
+    ColumnStore columns;    // Columnar copy for scans, built on demand (see table_columns())
+    TrigramIndex trigrams;  // Substring index on name/department, built by the first search that can use it
+    RangeIndex age_index;   // Sorted (age, id), built by the first /range query on age
+    RangeIndex salary_index; // Sorted (salary, id), built by the first /range query on salary
+    DeptAggregates dept_stats; // Per-department totals, built by the first /aggregates request
+    SortCache sorts;        // Sort permutations for /show?sort=, each valid for one version
+    FrozenTable *frozen;    // Latest row copy handed to full-table readers (NULL = none)
+
+    FILE *wal_fp;           // Open handle to bin/tables/<id>.wal (NULL until first write)
+    int wal_records;        // Records in the log since the last snapshot
+    int wal_unsynced;       // Log has writes that are not fsynced yet
+    int wal_broken;         // Log ends in a write that couldn't be cut off: snapshot instead of appending
+    int dirty;              // Snapshot is behind the log (checkpointer will flush)
+    uint64_t version;       // Bumped by every change to the rows, saved in the snapshot; sent as the ETag
+    uint32_t epoch;         // Random per load: versions a crash lost may be handed out again, never with the same epoch
+    ChangeRing changes;     // Recent changes by version, recorded once a client asks for /changes
+    uint64_t last_checkpoint_ms; // mg_millis() of the last snapshot
+    atomic_int unflushed;   // Rows changed or an index grew since the checkpointer last looked (table_mark_changed())
     
-    struct Table *next;     // For the global linked list of loaded tables
-    pthread_mutex_t lock;   // Concurrency lock
+    struct Table *next;     // Next table in the same directory bucket (table.c)
+    int refs;               // Requests holding the table (guarded by its directory stripe)
+    int referenced;         // CLOCK bit: looked up since the eviction hand last passed
+    size_t memory;          // Heap bytes at the last checkpointer tick (see table_memory())
+    int loading;            // 1 while the first request reads it from disk (guarded by its directory stripe)
+    int load_failed;        // Set with loading = 0 if the snapshot was damaged: waiters give up
+    pthread_rwlock_t lock;  // Shared for reads, exclusive for anything that changes the rows
+    pthread_mutex_t build_lock; // Lazy builds by readers holding 'lock' shared (indexes, sorts, frozen copy)
 } Table;
 
-extern Table *global_tables_head;
-extern pthread_mutex_t global_list_lock;
+// --- TABLE DIRECTORY SIZE ---
+#define TABLE_BUCKET_BITS 12
+#define TABLE_BUCKETS (1 << TABLE_BUCKET_BITS) // Hash buckets of loaded tables
+#define TABLE_STRIPES 64                       // Locks shared out over the buckets
 
 // --- FUNCTIONS ---
 
 // Load a table into RAM (or return existing). 
 // Requires owner_id for security verification.
-Table* get_or_load_table(int table_id, int owner_id);
+// The table stays in RAM until the caller hands it back with release_table().
+// A cold table is read from disk once, however many requests ask for it.
+// NULL on failure, with the HTTP status to answer in *status (403 / 500 / 503).
+Table* get_or_load_table(int table_id, int owner_id, int *status);
+
+// Reply text for a status from get_or_load_table()
+const char *table_error_text(int status);
+
+// Drop the reference taken by get_or_load_table() (after unlocking t->lock)
+void release_table(Table *t);
 
-// Unload a table from RAM (optional cleanup)
+// Unload a table from RAM (waits for the requests still holding it)
 void unload_table(int table_id);
 
+// Call visit() for every loaded table (tables still loading are skipped).
+// Each table is held by a reference during the call, with no directory lock
+// taken, so it can't be unloaded under it.
+void for_each_loaded_table(void (*visit)(Table *t, void *arg), void *arg);
+
+// --- EVICTION (CLOCK) ---
+// Next table nobody holds or used since the hand last passed, returned
+// with a reference; NULL if every table is busy or recently used.
+Table *pick_cold_table(void);
+
+// Drop a table picked above from RAM. Returns 0 once it is freed, -1 (and
+// releases it) if it is in use again or has writes the snapshot lacks.
+int evict_table(Table *t);
+
 #endif
\ No newline at end of file
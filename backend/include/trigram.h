@@ -0,0 +1,65 @@
+#ifndef TRIGRAM_H
+#define TRIGRAM_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "employee.h"
+#include "search.h"
+#include "skiplist.h"
+
+// --- TRIGRAM INDEX ---
+// Inverted index from every 3-character window of a row's (lowercased) name
+// and department to the rows containing it. Rows are numbered by "doc" in the
+// order they were added, so every posting list is sorted and appending keeps
+// it sorted. Removed rows only leave a hole in 'docs'; the postings are
+// filtered on read and the whole index is dropped once holes dominate.
+
+#define TRIGRAM_ALPHABET 28     // a-z, space, anything else
+#define TRIGRAM_KEYS (TRIGRAM_ALPHABET * TRIGRAM_ALPHABET * TRIGRAM_ALPHABET)
+
+typedef struct {
+    uint32_t *docs;         // Ascending
+    uint32_t len;
+    uint32_t capacity;
+} Posting;
+
+typedef enum {
+    TRIGRAM_IN_ORDER,       // Doc order is stored list order
+    TRIGRAM_UNORDERED       // Results are put back in list order by skip-list rank
+} TrigramOrder;
+
+typedef struct {
+    int built;              // 0 = not maintained; build before use
+    Posting *postings;      // TRIGRAM_KEYS entries
+    emp **docs;             // doc -> node (NULL once removed)
+    size_t doc_count;
+    size_t doc_capacity;
+    size_t dead;
+    TrigramOrder order;
+} TrigramIndex;
+
+void trigram_init(TrigramIndex *ti);
+void trigram_free(TrigramIndex *ti);
+
+// Index every node of the list (0 on success, -1 if out of memory)
+int trigram_build(TrigramIndex *ti, const EmployeeList *list);
+
+// Keep a built index in step with the list (no-ops while not built).
+// 'appended' = the node went to the stored tail of the list.
+void trigram_add(TrigramIndex *ti, emp *node, int appended);
+void trigram_remove(TrigramIndex *ti, emp *node);
+
+// Can this query be answered from the index? (3+ characters that can't match
+// a number, so only name and department need checking)
+int trigram_usable(const SearchNeedle *n);
+
+// Rows whose name or department contains the needle, in list order ('skip'
+// indexes 'list' and ranks the matches once docs no longer follow it).
+// Returns the match count (*out must be freed) or -1 if out of memory.
+long trigram_search(TrigramIndex *ti, const EmployeeList *list, const SkipIndex *skip,
+                    const SearchNeedle *n, emp ***out);
+
+#endif
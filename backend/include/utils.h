@@ -11,6 +11,8 @@
 #include "mongoose.h"
 #include "employee.h"
 #include "table.h" 
+#include "stream.h"
+#include "payload.h"
 // Note: table.h includes storage.h, so we have access to User structs if needed
 
 // --- HELPER: String Validation ---
@@ -23,23 +25,105 @@ int is_method(struct mg_http_message *hm, const char *method);
 // Validates raw data before creating a node
 const char *validate_core_logic(Table *t, int id, char *name, int age, char *dept, int salary);
 
+// Same checks when the strings were already scanned (alpha-only flag + full length)
+const char *validate_core_fields(Table *t, int id, bool name_alpha, size_t name_len, bool dept_alpha, size_t dept_len, int age, int salary);
+
+// --- HELPER: Pagination (?limit=N&cursor=<id>:<served>) ---
+// The cursor names the last row already sent, so rows inserted or removed
+// elsewhere don't shift the next page. 'served' (rows sent so far) is only
+// used to resume when that row itself has been deleted since.
+typedef struct {
+    int limit;          // 0 = not paged: reply with the plain array as before
+    int has_cursor;
+    int after_id;
+    long served;
+} PageRequest;
+
+// Returns 0 on success, -1 for a malformed limit or cursor
+int parse_page_request(struct mg_http_message *hm, PageRequest *page);
+
+// Open / close a streamed row list: the plain array when not paged, otherwise
+// { "rows": [...], "epoch": <table epoch>, "version": <table version>, "next_cursor": "<id>:<served>" | null }
+void page_stream_open(JsonStream *js, const PageRequest *page);
+void page_stream_close(JsonStream *js, const PageRequest *page, int has_more, int last_id, long served,
+                       uint32_t epoch, uint64_t version);
+
+// --- HELPER: Sorted reads (?sort=field[,field]&order=asc|desc) ---
+// Leaves key->field_count at 0 when there is no 'sort' parameter.
+// Returns 0 on success, -1 for an unknown field or order.
+int parse_sort_request(struct mg_http_message *hm, SortKey *key);
+
+// --- HELPER: ETag / If-None-Match on the table version ---
+// Writes the table's current ETag into 'etag' (call under t->lock) and
+// returns 1 if the request already holds it, i.e. the reply can be a 304
+#define ETAG_MAX 48
+int table_etag_matches(Table *t, struct mg_http_message *hm, char *etag, size_t size);
+
+// Empty 304 reply carrying the ETag
+void reply_not_modified(struct mg_connection *c, const char *etag);
+
 // --- HELPER: Case-Insensitive String Contains ---
 // Returns 1 if 'needle' is found inside 'haystack' (ignoring case), 0 otherwise
 int str_contains_ci(const char *haystack, const char *needle);
 
-// --- HELPER: JSON Validations ---
-// Validates incoming JSON for employee creation
-const char* validate_employee_json(cJSON *j_data, Table *t);
+// --- HELPER: Payload Validations ---
+// Validates a parsed /insert body for employee creation
+const char *validate_employee_payload(const EmployeePayload *p, Table *t);
 
-// --- HELPER: Recursive Reverse ---
-// Helper for the recursive reverse JSON builder
-void recursive_json_builder(emp *curr, cJSON *json_array);
+// --- HELPER: Reverse Order Read ---
+// Streams every row of the copy, last row first (iterative)
+void reverse_json_builder(const FrozenTable *rows, JsonStream *js);
 
 // --- HELPER: Linked List Operations ---
-// Add to end of list (RAM only)
-void append_to_list(Table *t, int id, char *name, int age, char *dept, int salary);
+// Add to end of list (RAM only). Returns the new node, NULL on allocation failure.
+emp *append_to_list(Table *t, int id, char *name, int age, char *dept, int salary);
 
 // Insert at specific position (RAM only)
 void insert_node_at_pos(Table *t, emp *insert, int position);
 
+// Find a node by ID through the table's hash index (NULL if missing)
+emp *find_node_by_id(Table *t, int id);
+
+// Row at a position as clients see it (NULL past the tail), and back
+emp *table_row_at(Table *t, size_t pos);
+size_t table_row_rank(Table *t, const emp *node);
+
+// Unlink a node that is currently in the table's list. Caller frees.
+void detach_node(Table *t, emp *node);
+
+// Unlink the node with the given ID and return it (NULL if missing). Caller frees.
+emp *detach_node_by_id(Table *t, int id);
+
+// Reverse the list by flipping its reading direction (RAM only, O(1))
+void reverse_list(Table *t);
+
+// Up-to-date columnar copy of the table for scans (NULL if out of memory)
+ColumnStore *table_columns(Table *t);
+
+// Trigram index of the table, built on first use (NULL if disabled or out of memory)
+TrigramIndex *table_trigrams(Table *t);
+
+// Sorted index for field "age" or "salary", built on first use (NULL for any other field or out of memory)
+RangeIndex *table_range_index(Table *t, const char *field);
+
+// Per-department aggregates, built on first use (NULL if out of memory)
+DeptAggregates *table_dept_stats(Table *t);
+
+// Immutable copy of the rows at the current version (NULL if out of memory).
+// Take it under t->lock (shared is enough), read it unlocked, then frozen_release() it.
+FrozenTable *table_freeze(Table *t);
+
+// Release a node that is no longer linked into the table's list
+void free_node(Table *t, emp *node);
+
+// Relayout policy and step for the node slabs (call while holding t->lock)
+int table_needs_compaction(Table *t);
+int compact_table(Table *t);
+
+// Approximate heap bytes held by the table, indexes included (call while holding t->lock)
+size_t table_memory(Table *t);
+
+// Flag the table for the checkpointer's next tick; tables without it are skipped unlocked
+void table_mark_changed(Table *t);
+
 #endif
\ No newline at end of file
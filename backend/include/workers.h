@@ -0,0 +1,36 @@
+#ifndef WORKERS_H
+#define WORKERS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mongoose.h"
+
+// --- WORKER POOL ---
+// The event loop only does socket I/O. Each complete request is copied into
+// a job and run by one of EMS_WORKERS threads against a private connection
+// that captures the reply; the worker then pokes the event loop with
+// mg_wakeup() and the captured bytes are moved onto the real connection.
+// Mongoose keeps c->is_resp set while a job is out, so pipelined requests
+// on the same connection wait in its receive buffer and stay in order.
+
+#define WORKERS_MAX 64
+
+typedef void (*RequestHandler)(struct mg_connection *c, struct mg_http_message *hm);
+
+// Start 'count' threads running 'handler' (call after mg_mgr_init).
+// Returns 0 on success, -1 if the pool could not start (serve inline then).
+int start_workers(struct mg_mgr *mgr, int count, RequestHandler handler);
+
+// Run what is still queued, then join the threads (before mg_mgr_free)
+void stop_workers(void);
+
+// Queue the request on connection 'c' (MG_EV_HTTP_MSG).
+// Returns 0 once queued, -1 if it has to be served inline.
+int workers_submit(struct mg_connection *c, struct mg_http_message *hm);
+
+// Let the pool see MG_EV_WAKEUP / MG_EV_POLL / MG_EV_CLOSE for 'c'
+void workers_event(struct mg_connection *c, int ev);
+
+#endif
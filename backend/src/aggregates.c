@@ -0,0 +1,157 @@
+// File_Name aggregates.c
+// Per-department statistics maintained alongside the employee list
+
+#include "aggregates.h"
+
+#define AGG_INITIAL_SLOTS 16
+
+void agg_init(DeptAggregates *a)
+{
+    memset(a, 0, sizeof(*a));
+}
+
+void agg_free(DeptAggregates *a)
+{
+    for (size_t i = 0; i < a->capacity; i++)
+        range_index_free(&a->slots[i].salaries);
+    free(a->slots);
+    agg_init(a);
+}
+
+int agg_age_bucket(int age)
+{
+    if (age < 0)
+        return 0;
+    return age / 10 < AGG_AGE_BUCKETS ? age / 10 : AGG_AGE_BUCKETS - 1;
+}
+
+int agg_salary_bounds(const DeptStats *d, int *min, int *max)
+{
+    return d->count > 0 && range_index_bounds(&d->salaries, min, max);
+}
+
+// Helper: FNV-1a over the department name
+static size_t hash_name(const char *name)
+{
+    size_t h = 2166136261u;
+    for (; *name; name++)
+    {
+        h ^= (unsigned char)*name;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// Helper: slot holding 'name', or the free slot it would go in
+static DeptStats *find_slot(DeptStats *slots, size_t capacity, const char *name)
+{
+    size_t i = hash_name(name) & (capacity - 1);
+    while (slots[i].taken && strcmp(slots[i].name, name) != 0)
+        i = (i + 1) & (capacity - 1);
+    return &slots[i];
+}
+
+static int grow(DeptAggregates *a)
+{
+    size_t capacity = a->capacity ? a->capacity * 2 : AGG_INITIAL_SLOTS;
+    DeptStats *slots = (DeptStats *)calloc(capacity, sizeof(DeptStats));
+    if (slots == NULL)
+        return -1;
+
+    // Stats move by value: a RangeIndex only points at its own arrays
+    for (size_t i = 0; i < a->capacity; i++)
+    {
+        if (a->slots[i].taken)
+            *find_slot(slots, capacity, a->slots[i].name) = a->slots[i];
+    }
+    free(a->slots);
+    a->slots = slots;
+    a->capacity = capacity;
+    return 0;
+}
+
+// Helper: stats of a department, created on first sight (NULL if out of memory)
+static DeptStats *dept_of(DeptAggregates *a, const char *name, int create)
+{
+    if (a->capacity == 0)
+    {
+        if (!create || grow(a) != 0)
+            return NULL;
+    }
+
+    DeptStats *d = find_slot(a->slots, a->capacity, name);
+    if (d->taken || !create)
+        return d->taken ? d : NULL;
+
+    // Keep the table at most half full
+    if ((a->used + 1) * 2 > a->capacity)
+    {
+        if (grow(a) != 0)
+            return NULL;
+        d = find_slot(a->slots, a->capacity, name);
+    }
+
+    d->taken = 1;
+    strncpy(d->name, name, sizeof(d->name) - 1);
+    a->used++;
+    return d;
+}
+
+// Helper: count one row in (delta = 1) or out (delta = -1); -1 if out of memory
+static int account(DeptAggregates *a, const emp *node, int delta)
+{
+    DeptStats *d = dept_of(a, node->department, delta > 0);
+    if (d == NULL)
+        return delta > 0 ? -1 : 0;
+
+    if (delta > 0)
+    {
+        if (d->count == 0 && range_index_build(&d->salaries, NULL, 0) != 0)
+            return -1;
+        range_index_add(&d->salaries, node->salary, node->id);
+        d->count++;
+    }
+    else
+    {
+        if (d->count == 0)
+            return 0;
+        range_index_remove(&d->salaries, node->salary, node->id);
+        d->count--;
+        if (d->count == 0)
+            range_index_free(&d->salaries); // Slot stays; memory goes
+    }
+
+    d->salary_sum += delta * (long long)node->salary;
+    d->age_sum += delta * (long long)node->age;
+    d->age_buckets[agg_age_bucket(node->age)] += delta;
+
+    // The salary index drops itself when it can't grow
+    return (d->count > 0 && !d->salaries.built) ? -1 : 0;
+}
+
+int agg_build(DeptAggregates *a, const EmployeeList *list)
+{
+    agg_free(a);
+    a->built = 1;
+    for (const emp *curr = list->head; curr != NULL; curr = curr->next)
+    {
+        if (account(a, curr, 1) != 0)
+        {
+            agg_free(a);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void agg_add(DeptAggregates *a, const emp *node)
+{
+    if (a->built && account(a, node, 1) != 0)
+        agg_free(a);
+}
+
+void agg_remove(DeptAggregates *a, const emp *node)
+{
+    if (a->built && account(a, node, -1) != 0)
+        agg_free(a);
+}
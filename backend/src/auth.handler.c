@@ -82,6 +82,19 @@ void handle_registry(struct mg_connection *c, struct mg_http_message *hm)
   cJSON_Delete(json);
 }
 
+// --- HELPER: strtok(line, "|") without its hidden static state (handlers run on several threads) ---
+static char *next_log_field(char **rest)
+{
+  char *start = *rest + strspn(*rest, "|");
+  if (*start == '\0')
+    return NULL;
+
+  char *end = start + strcspn(start, "|");
+  *rest = (*end != '\0') ? end + 1 : end;
+  *end = '\0';
+  return start;
+}
+
 //  3. READS THE LOG FILES FOR INDIVIDUAL USERS
 void handle_history(struct mg_connection *c, struct mg_http_message *hm)
 {
@@ -112,9 +125,10 @@ void handle_history(struct mg_connection *c, struct mg_http_message *hm)
     line[strcspn(line, "\n")] = 0; // Strip newline
 
     // Split by the pipe character '|'
-    char *timestamp = strtok(line, "|");
-    char *action = strtok(NULL, "|");
-    char *details = strtok(NULL, "|");
+    char *rest = line;
+    char *timestamp = next_log_field(&rest);
+    char *action = next_log_field(&rest);
+    char *details = next_log_field(&rest);
 
     if (timestamp && action && details)
     {
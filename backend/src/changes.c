@@ -0,0 +1,77 @@
+// File_Name changes.c
+// Bounded log of recent list changes for delta sync
+
+#include "changes.h"
+
+void change_ring_init(ChangeRing *r)
+{
+    r->entries = NULL;
+    r->since = 0;
+}
+
+void change_ring_free(ChangeRing *r)
+{
+    free(r->entries);
+    change_ring_init(r);
+}
+
+int change_ring_start(ChangeRing *r, uint64_t version)
+{
+    if (r->entries != NULL)
+        return 0;
+
+    r->entries = (Change *)calloc(CHANGE_RING_SIZE, sizeof(Change));
+    if (r->entries == NULL)
+        return -1;
+    r->since = version;
+    return 0;
+}
+
+void change_ring_record(ChangeRing *r, uint64_t version, ChangeOp op, int position, const emp *node)
+{
+    if (r->entries == NULL)
+        return;
+
+    Change *slot = &r->entries[version % CHANGE_RING_SIZE];
+    memset(slot, 0, sizeof(*slot));
+    slot->version = version;
+    slot->op = op;
+    slot->position = position;
+    if (op == CHANGE_INSERT)
+    {
+        slot->row.id = node->id;
+        slot->row.age = node->age;
+        slot->row.salary = node->salary;
+        memcpy(slot->row.name, node->name, sizeof(slot->row.name));
+        memcpy(slot->row.department, node->department, sizeof(slot->row.department));
+    }
+    else if (op == CHANGE_DELETE)
+    {
+        slot->row.id = node->id;
+    }
+}
+
+void change_ring_rewind(ChangeRing *r, uint64_t version, uint64_t reached)
+{
+    if (r->entries == NULL || reached <= version)
+        return;
+
+    if (reached > CHANGE_RING_SIZE && r->since < reached - CHANGE_RING_SIZE)
+        r->since = reached - CHANGE_RING_SIZE;
+    if (r->since > version)
+        r->since = version;
+}
+
+int change_ring_covers(const ChangeRing *r, uint64_t since, uint64_t version)
+{
+    if (r->entries == NULL || since < r->since || since > version)
+        return 0;
+
+    // Older slots have been overwritten once the ring wrapped
+    return version - since <= CHANGE_RING_SIZE;
+}
+
+const Change *change_ring_get(const ChangeRing *r, uint64_t version)
+{
+    return &r->entries[version % CHANGE_RING_SIZE];
+}
@@ -0,0 +1,165 @@
+// File_Name checkpointer.c
+// Flushes dirty tables to disk off the request path
+
+#include <time.h>
+
+#include "mongoose.h"
+#include "checkpointer.h"
+#include "config.h"
+#include "storage.h"
+#include "utils.h"
+
+static pthread_t checkpointer_thread;
+static pthread_mutex_t checkpointer_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t checkpointer_wake = PTHREAD_COND_INITIALIZER;
+static int checkpointer_running = 0;
+
+// Sync the log and, when due (or forced), fold it into a new snapshot
+static void flush_table(Table *t, int force)
+{
+    // Idle since the last tick: nothing to sync, compact or measure, so don't lock it
+    if (!atomic_exchange(&t->unflushed, 0) && !force)
+        return;
+
+    pthread_rwlock_wrlock(&t->lock);
+
+    wal_sync(t);
+
+    if (t->dirty &&
+        (force ||
+         t->wal_records >= WAL_CHECKPOINT_RECORDS ||
+         mg_millis() - t->last_checkpoint_ms >= (uint64_t)server_config.checkpoint_ms))
+    {
+        checkpoint_table(t);
+    }
+
+    // Scattered nodes make every traversal a chain of cache misses
+    if (table_needs_compaction(t) && compact_table(t) == 0)
+    {
+        printf("[MEMORY] Table %d relaid out into one slab (%zu rows).\n", t->id, t->nodes.live);
+    }
+
+    // A row copy nobody can be handed any more (readers still using it hold their own reference)
+    if (t->frozen != NULL && t->frozen->version != t->version)
+    {
+        frozen_release(t->frozen);
+        t->frozen = NULL;
+    }
+
+    if (server_config.table_memory_mb > 0)
+        t->memory = table_memory(t);
+
+    // A snapshot that isn't due yet still needs a look on a later tick
+    if (t->dirty || t->wal_unsynced)
+        table_mark_changed(t);
+
+    pthread_rwlock_unlock(&t->lock);
+}
+
+static void flush_visit(Table *t, void *arg)
+{
+    flush_table(t, *(const int *)arg);
+}
+
+static void flush_all_tables(int force)
+{
+    // The directory holds a reference on each table, so unload_table() can't free it under us
+    for_each_loaded_table(flush_visit, &force);
+}
+
+typedef struct {
+    size_t bytes;
+    size_t tables;
+} LoadedTotals;
+
+static void total_visit(Table *t, void *arg)
+{
+    LoadedTotals *totals = (LoadedTotals *)arg;
+    totals->bytes += t->memory;
+    totals->tables++;
+}
+
+// Evict cold tables (CLOCK order) until the loaded ones fit the memory budget
+static void evict_cold_tables(size_t budget)
+{
+    LoadedTotals totals = {0, 0};
+    for_each_loaded_table(total_visit, &totals);
+
+    // Each loaded table gets at most one try per tick
+    for (size_t tries = 0; totals.bytes > budget && tries < totals.tables; tries++)
+    {
+        Table *t = pick_cold_table();
+        if (t == NULL)
+            break; // Everything is in use or was used since the hand last passed
+
+        // Snapshot first so the log is empty and a reload is a single read
+        flush_table(t, 1);
+
+        int id = t->id;
+        size_t bytes = t->memory;
+        if (evict_table(t) == 0)
+        {
+            totals.bytes -= bytes < totals.bytes ? bytes : totals.bytes;
+            printf("[MEMORY] Table %d evicted (%zu KB), %zu KB still loaded.\n", id, bytes / 1024, totals.bytes / 1024);
+        }
+    }
+}
+
+static void *checkpointer_main(void *arg)
+{
+    (void)arg;
+
+    pthread_mutex_lock(&checkpointer_lock);
+    while (checkpointer_running)
+    {
+        // Sleep one tick (or until stop_checkpointer() wakes us)
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += server_config.group_commit_ms / 1000;
+        deadline.tv_nsec += (long)(server_config.group_commit_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L)
+        {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        pthread_cond_timedwait(&checkpointer_wake, &checkpointer_lock, &deadline);
+
+        if (!checkpointer_running)
+            break;
+
+        pthread_mutex_unlock(&checkpointer_lock);
+        flush_all_tables(0);
+        if (server_config.table_memory_mb > 0)
+            evict_cold_tables((size_t)server_config.table_memory_mb * 1024 * 1024);
+        pthread_mutex_lock(&checkpointer_lock);
+    }
+    pthread_mutex_unlock(&checkpointer_lock);
+    return NULL;
+}
+
+int start_checkpointer(void)
+{
+    checkpointer_running = 1;
+    if (pthread_create(&checkpointer_thread, NULL, checkpointer_main, NULL) != 0)
+    {
+        checkpointer_running = 0;
+        perror("Failed to start checkpointer");
+        return -1;
+    }
+    return 0;
+}
+
+void stop_checkpointer(void)
+{
+    pthread_mutex_lock(&checkpointer_lock);
+    int was_running = checkpointer_running;
+    checkpointer_running = 0;
+    pthread_cond_signal(&checkpointer_wake);
+    pthread_mutex_unlock(&checkpointer_lock);
+
+    if (was_running)
+        pthread_join(checkpointer_thread, NULL);
+
+    // Final flush: nothing dirty may be left behind on a clean shutdown
+    flush_all_tables(1);
+}
@@ -0,0 +1,164 @@
+// File_Name columns.c
+// Struct-of-arrays copy of a table for scan-heavy queries
+
+#include "columns.h"
+
+#define COLUMNS_MIN_DEAD_ROWS 1024  // Removed rows tolerated before the store asks for a rebuild
+#define COLUMNS_MIN_DEAD_TEXT 65536 // Same for text no row points at (updates put back in place leave some)
+
+void columns_init(ColumnStore *cs)
+{
+    memset(cs, 0, sizeof(*cs));
+}
+
+void columns_free(ColumnStore *cs)
+{
+    free(cs->id);
+    free(cs->age);
+    free(cs->salary);
+    free(cs->name_off);
+    free(cs->dept_off);
+    free(cs->name_len);
+    free(cs->dept_len);
+    free(cs->removed);
+    free(cs->text);
+    columns_init(cs);
+}
+
+// Helper: realloc one column, keeping the old array on failure
+static int grow_column(void **column, size_t count, size_t width)
+{
+    void *grown = realloc(*column, count * width);
+    if (grown == NULL)
+        return -1;
+    *column = grown;
+    return 0;
+}
+
+static int reserve_rows(ColumnStore *cs, size_t rows)
+{
+    if (rows <= cs->row_capacity)
+        return 0;
+
+    size_t capacity = cs->row_capacity ? cs->row_capacity : 256;
+    while (capacity < rows)
+        capacity *= 2;
+
+    if (grow_column((void **)&cs->id, capacity, sizeof(int)) ||
+        grow_column((void **)&cs->age, capacity, sizeof(int)) ||
+        grow_column((void **)&cs->salary, capacity, sizeof(int)) ||
+        grow_column((void **)&cs->name_off, capacity, sizeof(uint32_t)) ||
+        grow_column((void **)&cs->dept_off, capacity, sizeof(uint32_t)) ||
+        grow_column((void **)&cs->name_len, capacity, sizeof(uint8_t)) ||
+        grow_column((void **)&cs->dept_len, capacity, sizeof(uint8_t)) ||
+        grow_column((void **)&cs->removed, capacity, sizeof(uint8_t)))
+    {
+        return -1;
+    }
+
+    cs->row_capacity = capacity;
+    return 0;
+}
+
+static int reserve_text(ColumnStore *cs, size_t bytes)
+{
+    if (bytes <= cs->text_capacity)
+        return 0;
+
+    size_t capacity = cs->text_capacity ? cs->text_capacity : 4096;
+    while (capacity < bytes)
+        capacity *= 2;
+
+    if (grow_column((void **)&cs->text, capacity, 1))
+        return -1;
+
+    cs->text_capacity = capacity;
+    return 0;
+}
+
+// Helper: copy a string into the text buffer (room must be reserved)
+static uint32_t push_text(ColumnStore *cs, const char *str, uint8_t *len_out)
+{
+    size_t len = strnlen(str, 49);
+    uint32_t offset = (uint32_t)cs->text_len;
+
+    memcpy(cs->text + cs->text_len, str, len);
+    cs->text[cs->text_len + len] = '\0';
+    cs->text_len += len + 1;
+
+    *len_out = (uint8_t)len;
+    return offset;
+}
+
+// Helper: write a node into row 'i' (room must be reserved)
+static void put_row(ColumnStore *cs, emp *node, size_t i)
+{
+    cs->id[i] = node->id;
+    cs->age[i] = node->age;
+    cs->salary[i] = node->salary;
+    cs->name_off[i] = push_text(cs, node->name, &cs->name_len[i]);
+    cs->dept_off[i] = push_text(cs, node->department, &cs->dept_len[i]);
+    cs->removed[i] = 0;
+    node->col = (unsigned int)i;
+}
+
+int columns_append(ColumnStore *cs, emp *node)
+{
+    // Two strings of at most 49 chars plus terminators
+    if (reserve_rows(cs, cs->rows + 1) || reserve_text(cs, cs->text_len + 100))
+        return -1;
+
+    put_row(cs, node, cs->rows);
+    cs->rows++;
+    return 0;
+}
+
+int columns_insert(ColumnStore *cs, emp *node)
+{
+    if (node->next == NULL)
+        return columns_append(cs, node);
+
+    // Only removed rows lie between the predecessor's row and the successor's,
+    // so if the one right before the successor's is removed it keeps list order
+    size_t next = node->next->col;
+    if (next == 0 || next >= cs->rows || !cs->removed[next - 1] || reserve_text(cs, cs->text_len + 100))
+        return -1;
+
+    put_row(cs, node, next - 1);
+    cs->dead_rows--;
+    return 0;
+}
+
+void columns_remove(ColumnStore *cs, const emp *node)
+{
+    size_t i = node->col;
+    if (i >= cs->rows || cs->removed[i] || cs->id[i] != node->id)
+        return;
+
+    cs->removed[i] = 1;
+    cs->dead_rows++;
+    cs->text_dead += (size_t)cs->name_len[i] + cs->dept_len[i] + 2;
+
+    // Mostly holes or garbage: let the next scan rebuild it packed
+    if ((cs->dead_rows >= COLUMNS_MIN_DEAD_ROWS && cs->dead_rows * 2 > cs->rows) ||
+        (cs->text_dead >= COLUMNS_MIN_DEAD_TEXT && cs->text_dead * 2 > cs->text_len))
+        cs->valid = 0;
+}
+
+int columns_build(ColumnStore *cs, const EmployeeList *list)
+{
+    cs->valid = 0;
+    cs->rows = 0;
+    cs->dead_rows = 0;
+    cs->text_len = 0;
+    cs->text_dead = 0;
+
+    for (emp *curr = list->head; curr != NULL; curr = curr->next)
+    {
+        if (columns_append(cs, curr) != 0)
+            return -1;
+    }
+
+    cs->valid = 1;
+    return 0;
+}
@@ -0,0 +1,110 @@
+// File_Name config.c
+// Reads startup settings from the environment
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "config.h"
+
+// Defaults used when a variable is missing or invalid
+ServerConfig server_config = {
+    DURABILITY_GROUP, // durability
+    50,               // group_commit_ms
+    5000,             // checkpoint_ms
+    1,                // trigram_index
+    -1,               // workers (-1 = one per online core)
+    1024              // table_memory_mb
+};
+
+// Helper: Read a positive integer variable
+static int env_int(const char *name, int fallback)
+{
+    const char *value = getenv(name);
+    if (value == NULL || *value == '\0')
+    {
+        return fallback;
+    }
+    int parsed = atoi(value);
+    return parsed > 0 ? parsed : fallback;
+}
+
+// Helper: Read an on/off variable ("0"/"1")
+static int env_flag(const char *name, int fallback)
+{
+    const char *value = getenv(name);
+    if (value == NULL || *value == '\0')
+    {
+        return fallback;
+    }
+    return strcmp(value, "0") != 0;
+}
+
+// Helper: Read a count where 0 is meaningful
+static int env_count(const char *name, int fallback)
+{
+    const char *value = getenv(name);
+    if (value == NULL || *value == '\0')
+    {
+        return fallback;
+    }
+    int parsed = atoi(value);
+    return parsed >= 0 ? parsed : fallback;
+}
+
+// Helper: Number of cores the server can run on
+static int online_cores(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores > 0 ? (int)cores : 1;
+#endif
+}
+
+void load_server_config(void)
+{
+    const char *mode = getenv("EMS_DURABILITY");
+    if (mode != NULL)
+    {
+        if (strcmp(mode, "sync") == 0)
+            server_config.durability = DURABILITY_SYNC;
+        else if (strcmp(mode, "group") == 0)
+            server_config.durability = DURABILITY_GROUP;
+        else if (strcmp(mode, "async") == 0)
+            server_config.durability = DURABILITY_ASYNC;
+        else
+            printf("[CONFIG] Unknown EMS_DURABILITY '%s', using '%s'\n", mode, durability_name(server_config.durability));
+    }
+
+    server_config.group_commit_ms = env_int("EMS_GROUP_COMMIT_MS", server_config.group_commit_ms);
+    server_config.checkpoint_ms = env_int("EMS_CHECKPOINT_MS", server_config.checkpoint_ms);
+    server_config.trigram_index = env_flag("EMS_TRIGRAM_INDEX", server_config.trigram_index);
+    server_config.workers = env_count("EMS_WORKERS", server_config.workers);
+    if (server_config.workers < 0)
+        server_config.workers = online_cores();
+    server_config.table_memory_mb = env_count("EMS_TABLE_MEMORY_MB", server_config.table_memory_mb);
+
+    printf("[CONFIG] Durability: %s (group commit %d ms, checkpoint %d ms), trigram index %s, %d workers, table memory %d MB\n",
+           durability_name(server_config.durability), server_config.group_commit_ms, server_config.checkpoint_ms,
+           server_config.trigram_index ? "on" : "off", server_config.workers, server_config.table_memory_mb);
+}
+
+const char *durability_name(DurabilityMode mode)
+{
+    switch (mode)
+    {
+    case DURABILITY_SYNC:
+        return "sync";
+    case DURABILITY_GROUP:
+        return "group";
+    case DURABILITY_ASYNC:
+        return "async";
+    }
+    return "unknown";
+}
@@ -1,86 +1,166 @@
 // File_Name core.handler.c
 // Serves the logic for core operations
 
+#include <limits.h>
+
 #include "handlers.h"
 #include "employee.h"
 #include "utils.h"
 #include "table.h"
 #include "storage.h"
 #include "logs.h"
+#include "search.h"
+#include "filter.h"
 
 // --- 1. Handles insertion (Supports insertion at specific position) ---
 void handle_insertion(struct mg_connection *c, struct mg_http_message *hm)
 {
-  cJSON *json = cJSON_ParseWithLength(hm->body.buf, hm->body.len);
-  if (!json)
+  EmployeePayload payload;
+  if (parse_employee_payload(hm->body.buf, hm->body.len, &payload) != 0)
   {
     mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\n", "{ \"error\": \"Invalid JSON\" }");
     return;
   }
 
-  cJSON *j_table_id = cJSON_GetObjectItem(json, "table_id");
-  cJSON *j_owner_id = cJSON_GetObjectItem(json, "owner_id");
-
-  if (!j_table_id || !cJSON_IsNumber(j_table_id) || !j_owner_id || !cJSON_IsNumber(j_owner_id))
+  if (payload.table_id.kind != FIELD_NUMBER || payload.owner_id.kind != FIELD_NUMBER)
   {
 
     mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\n", "{ \"error\": \"Missing/Invalid table_id or owner_id\" }");
-    cJSON_Delete(json);
     return;
   }
 
-  Table *t = get_or_load_table(j_table_id->valueint, j_owner_id->valueint);
+  int load_status;
+  Table *t = get_or_load_table(payload.table_id.value, payload.owner_id.value, &load_status);
   if (!t)
   {
-    mg_http_reply(c, 403, "Access-Control-Allow-Origin: *\r\n", "{ \"error\": \"Access Denied\" }");
-    cJSON_Delete(json);
+    mg_http_reply(c, load_status, "Access-Control-Allow-Origin: *\r\n", "{ \"error\": \"%s\" }", table_error_text(load_status));
     return;
   }
 
-  cJSON *j_data = cJSON_GetObjectItem(json, "data");
+  pthread_rwlock_wrlock(&t->lock);
 
-  pthread_mutex_lock(&t->lock);
-
-  const char *error_msg = validate_employee_json(j_data, t);
+  const char *error_msg = validate_employee_payload(&payload, t);
   if (error_msg != NULL)
   {
-    pthread_mutex_unlock(&t->lock);
+    pthread_rwlock_unlock(&t->lock);
+    release_table(t);
     mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\n", "{ \"message\": \"%s\" }", error_msg);
-    cJSON_Delete(json);
     return;
   }
 
-  emp *insert = create_node_from_json(j_data);
+  emp *insert = record_to_node(&t->nodes, payload.record);
   if (insert == NULL)
   {
-    pthread_mutex_unlock(&t->lock);
+    pthread_rwlock_unlock(&t->lock);
+    release_table(t);
     mg_http_reply(c, 500, "Access-Control-Allow-Origin: *\r\n", "{ \"error\": \"Memory Error\" }");
-    cJSON_Delete(json);
     return;
   }
 
   int position = -1;
-  cJSON *j_pos = cJSON_GetObjectItem(json, "position");
-  if (j_pos)
-    position = j_pos->valueint;
+  if (payload.position.kind != FIELD_MISSING)
+    position = payload.position.value;
 
   insert_node_at_pos(t, insert, position);
 
-  save_table_binary(t);
+  int logged = wal_log_insert(t, insert, position);
 
   char log_details[128];
   snprintf(log_details, sizeof(log_details), "Added Employee: %s (ID: %d)", insert->name, insert->id);
-  add_log(j_owner_id->valueint, "INSERT", log_details);
+  add_log(payload.owner_id.value, "INSERT", log_details);
 
-  pthread_mutex_unlock(&t->lock);
+  // The node is only safe to touch while the table is locked
+  int inserted_id = insert->id;
+  pthread_rwlock_unlock(&t->lock);
+  release_table(t);
+
+  if (logged != 0)
+  {
+    mg_http_reply(c, 500, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"%s\" }", WAL_ERROR_TEXT);
+    return;
+  }
 
   mg_http_reply(c, 200, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
-                "{ \"status\": \"success\", \"id\": %d }", insert->id);
+                "{ \"status\": \"success\", \"id\": %d }", inserted_id);
+}
 
-  cJSON_Delete(json);
+// --- HELPER: Stream /show in sort order (call under t->lock, shared is enough) ---
+static void show_sorted(struct mg_connection *c, Table *t, const PageRequest *page, const SortKey *key,
+                        const char *etag_header)
+{
+  // Sorted once per table version and key; later pages reuse the permutation.
+  // Pinned, so a reader sorting by another key can't evict it while we stream.
+  pthread_mutex_lock(&t->build_lock);
+  uint64_t builds = t->sorts.builds;
+  SortedView *sorted = sort_cache_get(&t->sorts, &t->employeelist, t->skip.count, t->version, key);
+  if (t->sorts.builds != builds)
+    table_mark_changed(t);
+  pthread_mutex_unlock(&t->build_lock);
+  if (!sorted)
+  {
+    mg_http_reply(c, 500, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Server Memory Error\" }");
+    return;
+  }
+
+  // Resume right after the cursor's row, or by count if it was deleted
+  size_t start = 0;
+  if (page->has_cursor)
+  {
+    start = (size_t)page->served < sorted->count ? (size_t)page->served : sorted->count;
+    if (start == 0 || sorted->rows[start - 1]->id != page->after_id)
+    {
+      // The table changed since the last page: find the row by id
+      for (size_t i = 0; i < sorted->count; i++)
+      {
+        if (sorted->rows[i]->id == page->after_id)
+        {
+          start = i + 1;
+          break;
+        }
+      }
+    }
+  }
+
+  size_t end = sorted->count;
+  if (page->limit && start + (size_t)page->limit < end)
+  {
+    end = start + (size_t)page->limit;
+  }
+
+  JsonStream js;
+  json_stream_begin(&js, c, etag_header);
+  page_stream_open(&js, page);
+  for (size_t i = start; i < end; i++)
+  {
+    emp *node = sorted->rows[i];
+    json_stream_row(&js, node->id, node->name, node->age, node->department, node->salary);
+  }
+  page_stream_close(&js, page, end < sorted->count, end > start ? sorted->rows[end - 1]->id : page->after_id,
+                    (long)end, t->epoch, t->version);
+  json_stream_end(&js);
+
+  pthread_mutex_lock(&t->build_lock);
+  sort_cache_release(&t->sorts, sorted);
+  pthread_mutex_unlock(&t->build_lock);
 }
 
-// --- Handles Display (returns all employees as a JSON Array) ---
+// --- HELPER: Stream an unpaged /show from row 'start' of a row copy (no table lock held) ---
+static void show_frozen(struct mg_connection *c, const FrozenTable *rows, size_t start, const PageRequest *page,
+                        const char *etag_header)
+{
+  JsonStream js;
+  json_stream_begin(&js, c, etag_header);
+  page_stream_open(&js, page);
+  for (size_t i = start; i < rows->count; i++)
+  {
+    const EmployeeRecord *r = &rows->rows[i];
+    json_stream_row(&js, r->id, r->name, r->age, r->department, r->salary);
+  }
+  page_stream_close(&js, page, 0, 0, 0, 0, rows->version);
+  json_stream_end(&js);
+}
+
+// --- Handles Display (returns all employees as a JSON Array, or one page of them) ---
 void handle_showall(struct mg_connection *c, struct mg_http_message *hm)
 {
   // Extract 'table_id' from the URL Query String
@@ -92,56 +172,417 @@ void handle_showall(struct mg_connection *c, struct mg_http_message *hm)
     return;
   }
 
+  PageRequest page;
+  if (parse_page_request(hm, &page) != 0)
+  {
+    mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Invalid limit or cursor\" }");
+    return;
+  }
+
+  // Optional ?sort=field[,field]&order=asc|desc
+  SortKey sort_key;
+  if (parse_sort_request(hm, &sort_key) != 0)
+  {
+    mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
+                  "{ \"error\": \"Invalid sort or order (fields: id, name, age, department, salary)\" }");
+    return;
+  }
+
   // Get the specific Table
-  Table *t = get_or_load_table(atoi(table_id_str), atoi(owner_id_str));
+  int load_status;
+  Table *t = get_or_load_table(atoi(table_id_str), atoi(owner_id_str), &load_status);
   if (!t)
   {
-    mg_http_reply(c, 403, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Access Denied\" }");
+    mg_http_reply(c, load_status, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"%s\" }", table_error_text(load_status));
     return;
   }
 
-  cJSON *json_array = cJSON_CreateArray();
-
   // lock the specific table
-  pthread_mutex_lock(&t->lock);
+  pthread_rwlock_rdlock(&t->lock);
+
+  // Nothing changed since the client's copy: no rows touched
+  char etag[ETAG_MAX], etag_header[ETAG_MAX + 16];
+  if (table_etag_matches(t, hm, etag, sizeof(etag)))
+  {
+    pthread_rwlock_unlock(&t->lock);
+    release_table(t);
+    reply_not_modified(c, etag);
+    return;
+  }
+  snprintf(etag_header, sizeof(etag_header), "ETag: %s\r\n", etag);
 
-  emp *curr = t->employeelist.head;
+  if (sort_key.field_count)
+  {
+    show_sorted(c, t, &page, &sort_key, etag_header);
+    pthread_rwlock_unlock(&t->lock);
+    release_table(t);
+    return;
+  }
+
+  emp *curr = list_first(&t->employeelist);
+  long served = 0;
+
+  // Resume right after the cursor's row, or by count if it was deleted
+  if (page.has_cursor)
+  {
+    emp *anchor = find_node_by_id(t, page.after_id);
+    if (anchor)
+    {
+      curr = list_next(&t->employeelist, anchor);
+    }
+    else
+    {
+      curr = table_row_at(t, (size_t)page.served);
+    }
+    served = page.served;
+  }
 
-  // Traverse the Linked List
-  while (curr != NULL)
+  // Everything from here on: encode from a row copy with the table unlocked
+  if (page.limit == 0)
   {
-    // Map struct fields to JSON keys
-    cJSON *emp_obj = cJSON_CreateObject();
-    cJSON_AddNumberToObject(emp_obj, "id", curr->id);
-    cJSON_AddStringToObject(emp_obj, "name", curr->name);
-    cJSON_AddNumberToObject(emp_obj, "age", curr->age);
-    cJSON_AddStringToObject(emp_obj, "department", curr->department);
-    cJSON_AddNumberToObject(emp_obj, "salary", curr->salary);
+    size_t start = curr ? table_row_rank(t, curr) : t->skip.count;
+    FrozenTable *rows = table_freeze(t);
+    pthread_rwlock_unlock(&t->lock);
+    release_table(t);
+    if (!rows)
+    {
+      mg_http_reply(c, 500, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Server Memory Error\" }");
+      return;
+    }
+    show_frozen(c, rows, start, &page, etag_header);
+    frozen_release(rows);
+    return;
+  }
 
-    // Add object to array
-    cJSON_AddItemToArray(json_array, emp_obj);
-    curr = curr->next;
+  // Successful Response: rows are encoded straight into the send buffer
+  JsonStream js;
+  json_stream_begin(&js, c, etag_header);
+  page_stream_open(&js, &page);
+
+  // Traverse the Linked List (one page of it when a limit is given)
+  int last_id = 0;
+  while (curr != NULL && (page.limit == 0 || served < page.served + page.limit))
+  {
+    json_stream_row(&js, curr->id, curr->name, curr->age, curr->department, curr->salary);
+    last_id = curr->id;
+    served++;
+    curr = list_next(&t->employeelist, curr);
   }
 
-  // Convert JSON object to String
-  char *response_str = cJSON_PrintUnformatted(json_array);
+  page_stream_close(&js, &page, curr != NULL, last_id, served, t->epoch, t->version);
+  json_stream_end(&js);
 
   // Unlock the list
-  pthread_mutex_unlock(&t->lock);
+  pthread_rwlock_unlock(&t->lock);
+  release_table(t);
+}
 
-  // Successful Response with data
-  mg_http_reply(c, 200, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "%s", response_str);
+// --- HELPER: Ids of the matching rows, in list order (for paged searches) ---
+typedef struct
+{
+  int *ids;
+  size_t count;
+  size_t capacity;
+} MatchIds;
 
-  // Cleanup
-  free(response_str);
-  cJSON_Delete(json_array);
+static int push_match(MatchIds *m, int id)
+{
+  if (m->count == m->capacity)
+  {
+    size_t capacity = m->capacity ? m->capacity * 2 : 256;
+    int *grown = (int *)realloc(m->ids, capacity * sizeof(int));
+    if (grown == NULL)
+      return -1;
+    m->ids = grown;
+    m->capacity = capacity;
+  }
+  m->ids[m->count++] = id;
+  return 0;
+}
+
+// --- HELPER: Stream the matches the page asks for (all of them when not paged) ---
+static void stream_matches(JsonStream *js, Table *t, const PageRequest *page, const MatchIds *found)
+{
+  // Resume right after the cursor's row, or by count if it no longer matches
+  size_t start = 0;
+  if (page->has_cursor)
+  {
+    start = (size_t)page->served < found->count ? (size_t)page->served : found->count;
+    for (size_t i = 0; i < found->count; i++)
+    {
+      if (found->ids[i] == page->after_id)
+      {
+        start = i + 1;
+        break;
+      }
+    }
+  }
+
+  size_t end = found->count;
+  if (page->limit && start + (size_t)page->limit < end)
+  {
+    end = start + (size_t)page->limit;
+  }
+
+  for (size_t i = start; i < end; i++)
+  {
+    emp *node = find_node_by_id(t, found->ids[i]);
+    if (node)
+      json_stream_row(js, node->id, node->name, node->age, node->department, node->salary);
+  }
+  page_stream_close(js, page, end < found->count, end > 0 ? found->ids[end - 1] : 0, (long)end, t->epoch, t->version);
+}
+
+// --- HELPER: Does row 'i' of the columnar copy match the query? ---
+static int column_row_matches(const ColumnStore *cols, size_t i, const SearchNeedle *needle)
+{
+  if (cols->removed[i])
+    return 0;
+
+  // CHECK 1-2: Name / Department (case-insensitive, vectorized)
+  // CHECK 3-5: ID / Age / Salary (matched on the digits, no formatting)
+  return needle_in_text(needle, columns_name(cols, i), cols->name_len[i]) ||
+         needle_in_text(needle, columns_department(cols, i), cols->dept_len[i]) ||
+         needle_in_number(needle, cols->id[i]) ||
+         needle_in_number(needle, cols->age[i]) ||
+         needle_in_number(needle, cols->salary[i]);
+}
+
+// --- HELPER: Column row holding the k-th row in list order (stored order backwards when reversed) ---
+static size_t column_row(const Table *t, const ColumnStore *cols, size_t k)
+{
+  return t->employeelist.reversed ? cols->rows - 1 - k : k;
+}
+
+// --- HELPER: Pair a row's list position with its id (to restore list order) ---
+typedef struct
+{
+  size_t rank;
+  int id;
+} RankedId;
+
+static int compare_ranked(const void *a, const void *b)
+{
+  size_t x = ((const RankedId *)a)->rank, y = ((const RankedId *)b)->rank;
+  return (x > y) - (x < y);
+}
+
+static const FilterRow *node_filter_row(const emp *node, FilterRow *row)
+{
+  row->id = node->id;
+  row->age = node->age;
+  row->salary = node->salary;
+  row->name = node->name;
+  row->name_len = strnlen(node->name, sizeof(node->name));
+  row->department = node->department;
+  row->dept_len = strnlen(node->department, sizeof(node->department));
+  return row;
+}
+
+// --- HELPER: Ids of the rows a compiled filter accepts, in list order (call under t->lock) ---
+// Cheapest path first: an id lookup, then an age / salary index when the range
+// is selective, otherwise one pass over the columnar copy. Returns -1 if out of memory.
+static int collect_filtered(Table *t, const FilterProgram *prog, MatchIds *found)
+{
+  FilterPlan plan;
+  filter_plan(prog, &plan);
+  FilterRow row;
+
+  // 1. "id = N" in the top-level AND chain: at most one row to check
+  if (plan.has_id)
+  {
+    emp *node = find_node_by_id(t, plan.id);
+    if (node && filter_match(prog, node_filter_row(node, &row)))
+      return push_match(found, node->id);
+    return 0;
+  }
+
+  // 2. Age / salary bounds: take the narrower index if it leaves at most a quarter of the rows
+  RangeIndex *ri = NULL;
+  int min = 0, max = 0;
+  size_t candidates = t->skip.count / 4 + 1;
+  for (int f = 0; f < 2; f++)
+  {
+    int has = f == 0 ? plan.has_age : plan.has_salary;
+    RangeIndex *index = has ? table_range_index(t, f == 0 ? "age" : "salary") : NULL;
+    if (index == NULL)
+      continue;
+
+    int lo = f == 0 ? plan.age_min : plan.salary_min;
+    int hi = f == 0 ? plan.age_max : plan.salary_max;
+    size_t n = range_index_count(index, lo, hi);
+    if (n < candidates)
+    {
+      ri = index;
+      min = lo;
+      max = hi;
+      candidates = n;
+    }
+  }
+
+  if (ri != NULL)
+  {
+    RankedId *ranked = (RankedId *)malloc((candidates + 1) * sizeof(RankedId));
+    if (ranked == NULL)
+      return -1;
+
+    size_t n = 0;
+    int id;
+    RangeCursor cursor;
+    range_index_seek(ri, min, max, &cursor);
+    while (n < candidates && range_cursor_next(&cursor, &id))
+    {
+      emp *node = find_node_by_id(t, id);
+      if (node && filter_match(prog, node_filter_row(node, &row)))
+      {
+        ranked[n].rank = table_row_rank(t, node);
+        ranked[n].id = id;
+        n++;
+      }
+    }
+
+    // Index order is by value: put the matches back in list order
+    qsort(ranked, n, sizeof(RankedId), compare_ranked);
+    int rc = 0;
+    for (size_t i = 0; i < n && rc == 0; i++)
+      rc = push_match(found, ranked[i].id);
+    free(ranked);
+    return rc;
+  }
+
+  // 3. Full scan: the program reads the columns directly
+  ColumnStore *cols = table_columns(t);
+  if (cols != NULL)
+  {
+    for (size_t k = 0; k < cols->rows; k++)
+    {
+      size_t i = column_row(t, cols, k);
+      if (cols->removed[i])
+        continue;
+      row.id = cols->id[i];
+      row.age = cols->age[i];
+      row.salary = cols->salary[i];
+      row.name = columns_name(cols, i);
+      row.name_len = cols->name_len[i];
+      row.department = columns_department(cols, i);
+      row.dept_len = cols->dept_len[i];
+      if (filter_match(prog, &row) && push_match(found, row.id) != 0)
+        return -1;
+    }
+    return 0;
+  }
+
+  // No memory for the columns: walk the list instead
+  for (emp *curr = list_first(&t->employeelist); curr != NULL; curr = list_next(&t->employeelist, curr))
+  {
+    if (filter_match(prog, node_filter_row(curr, &row)) && push_match(found, curr->id) != 0)
+      return -1;
+  }
+  return 0;
+}
+
+// --- HELPER: /search?filter=<expression> (see filter.h for the syntax) ---
+static void handle_filtered_search(struct mg_connection *c, struct mg_http_message *hm, const char *filter_str)
+{
+  char table_id_str[32], owner_id_str[32];
+  if (mg_http_get_var(&hm->query, "table_id", table_id_str, sizeof(table_id_str)) <= 0 ||
+      mg_http_get_var(&hm->query, "owner_id", owner_id_str, sizeof(owner_id_str)) <= 0)
+  {
+    mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Missing params\" }");
+    return;
+  }
+
+  PageRequest page;
+  if (parse_page_request(hm, &page) != 0)
+  {
+    mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Invalid limit or cursor\" }");
+    return;
+  }
+
+  // Parsed and compiled once, before the table is even locked
+  FilterProgram *prog = (FilterProgram *)malloc(sizeof(FilterProgram));
+  if (prog == NULL)
+  {
+    mg_http_reply(c, 500, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Server Memory Error\" }");
+    return;
+  }
+
+  const char *error;
+  size_t error_pos;
+  if (filter_compile(filter_str, prog, &error, &error_pos) != 0)
+  {
+    free(prog);
+    mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
+                  "{ \"error\": \"Invalid filter: %s\", \"position\": %lu }", error, (unsigned long)error_pos);
+    return;
+  }
+
+  int load_status;
+  Table *t = get_or_load_table(atoi(table_id_str), atoi(owner_id_str), &load_status);
+  if (!t)
+  {
+    free(prog);
+    mg_http_reply(c, load_status, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"%s\" }", table_error_text(load_status));
+    return;
+  }
+
+  pthread_rwlock_rdlock(&t->lock);
+
+  // Nothing changed since the client's copy: no rows touched
+  char etag[ETAG_MAX], etag_header[ETAG_MAX + 16];
+  if (table_etag_matches(t, hm, etag, sizeof(etag)))
+  {
+    pthread_rwlock_unlock(&t->lock);
+    release_table(t);
+    free(prog);
+    reply_not_modified(c, etag);
+    return;
+  }
+  snprintf(etag_header, sizeof(etag_header), "ETag: %s\r\n", etag);
+
+  MatchIds found = {NULL, 0, 0};
+  if (collect_filtered(t, prog, &found) != 0)
+  {
+    pthread_rwlock_unlock(&t->lock);
+    release_table(t);
+    free(prog);
+    free(found.ids);
+    mg_http_reply(c, 500, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Server Memory Error\" }");
+    return;
+  }
+
+  JsonStream js;
+  json_stream_begin(&js, c, etag_header);
+  page_stream_open(&js, &page);
+  stream_matches(&js, t, &page, &found);
+  json_stream_end(&js);
+
+  pthread_rwlock_unlock(&t->lock);
+  release_table(t);
+  free(prog);
+  free(found.ids);
 }
 
-// --- Handles Search by ID (Linear Search: as the data is not sorted according to ID) ---
+// --- Handles Search (trigram index for text queries, columnar scan otherwise) ---
 void handle_search(struct mg_connection *c, struct mg_http_message *hm)
 {
   char query_str[50], table_id_str[32], owner_id_str[32];
 
+  // Structured filter instead of free text
+  char filter_str[512];
+  int filter_len = mg_http_get_var(&hm->query, "filter", filter_str, sizeof(filter_str));
+  if (filter_len > 0)
+  {
+    handle_filtered_search(c, hm, filter_str);
+    return;
+  }
+  if (filter_len == 0 || filter_len == -3)
+  {
+    mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
+                  "{ \"error\": \"Filter is empty or too long\" }");
+    return;
+  }
+
   if (mg_http_get_var(&hm->query, "query", query_str, sizeof(query_str)) <= 0)
   {
     if (mg_http_get_var(&hm->query, "id", query_str, sizeof(query_str)) <= 0)
@@ -161,159 +602,411 @@ void handle_search(struct mg_connection *c, struct mg_http_message *hm)
     return;
   }
 
+  PageRequest page;
+  if (parse_page_request(hm, &page) != 0)
+  {
+    mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Invalid limit or cursor\" }");
+    return;
+  }
+
   // Get the specific Table
-  Table *t = get_or_load_table(atoi(table_id_str), atoi(owner_id_str));
+  int load_status;
+  Table *t = get_or_load_table(atoi(table_id_str), atoi(owner_id_str), &load_status);
   if (!t)
   {
-    mg_http_reply(c, 403, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Access Denied\" }");
+    mg_http_reply(c, load_status, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"%s\" }", table_error_text(load_status));
     return;
   }
 
-  // lock the list
-  pthread_mutex_lock(&t->lock);
+  // Lowercase and classify the query once, not per row
+  SearchNeedle needle;
+  needle_prepare(&needle, query_str);
 
-  // Prepare JSON Array
-  cJSON *results_array = cJSON_CreateArray();
+  emp **matches = NULL;       // Trigram path: matching nodes in list order
+  long match_count = -1;
+  ColumnStore *cols = NULL;   // Scan path
 
-  emp *curr = t->employeelist.head;
-  int match_count = 0;
+  // lock the list
+  pthread_rwlock_rdlock(&t->lock);
 
-  // Buffer for converting numbers (ID/Age/Salary) to strings
-  char temp_buf[64];
+  // Nothing changed since the client's copy: no rows touched
+  char etag[ETAG_MAX], etag_header[ETAG_MAX + 16];
+  if (table_etag_matches(t, hm, etag, sizeof(etag)))
+  {
+    pthread_rwlock_unlock(&t->lock);
+    release_table(t);
+    reply_not_modified(c, etag);
+    return;
+  }
+  snprintf(etag_header, sizeof(etag_header), "ETag: %s\r\n", etag);
 
-  // Linear Search through the WHOLE list
-  while (curr != NULL)
+  // Fast path: text-only queries of 3+ characters go through the trigram index
+  TrigramIndex *trigrams = trigram_usable(&needle) ? table_trigrams(t) : NULL;
+  if (trigrams)
   {
-    int is_match = 0;
+    match_count = trigram_search(trigrams, &t->employeelist, &t->skip, &needle, &matches);
+    // Out of memory (-1): fall back to the scan
+  }
 
-    // CHECK 1: Name (String)
-    if (str_contains_ci(curr->name, query_str))
-      is_match = 1;
+  // Otherwise scan the columnar copy: numeric checks read only the int columns
+  if (match_count < 0)
+  {
+    cols = table_columns(t);
+  }
 
-    // CHECK 2: Department (String)
-    else if (str_contains_ci(curr->department, query_str))
-      is_match = 1;
+  // Paged searches only remember ids while matching, then emit one page
+  MatchIds found = {NULL, 0, 0};
+  int out_of_memory = match_count < 0 && cols == NULL;
+  if (page.limit && !out_of_memory)
+  {
+    for (long i = 0; i < match_count && !out_of_memory; i++)
+      out_of_memory = push_match(&found, matches[i]->id) != 0;
 
-    // CHECK 3: ID (Int -> String)
-    if (!is_match)
+    for (size_t k = 0; cols != NULL && k < cols->rows && !out_of_memory; k++)
     {
-      snprintf(temp_buf, sizeof(temp_buf), "%d", curr->id);
-      if (strstr(temp_buf, query_str))
-        is_match = 1;
+      size_t i = column_row(t, cols, k);
+      if (column_row_matches(cols, i, &needle))
+        out_of_memory = push_match(&found, cols->id[i]) != 0;
     }
+  }
+
+  if (out_of_memory)
+  {
+    pthread_rwlock_unlock(&t->lock);
+    release_table(t);
+    free(matches);
+    free(found.ids);
+    mg_http_reply(c, 500, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Server Memory Error\" }");
+    return;
+  }
+
+  // Response: rows are encoded straight into the send buffer
+  JsonStream js;
+  json_stream_begin(&js, c, etag_header);
+  page_stream_open(&js, &page);
 
-    // CHECK 4: Age (Int -> String)
-    if (!is_match)
+  if (page.limit)
+  {
+    stream_matches(&js, t, &page, &found);
+  }
+  else
+  {
+    for (long i = 0; i < match_count; i++)
     {
-      snprintf(temp_buf, sizeof(temp_buf), "%d", curr->age);
-      if (strstr(temp_buf, query_str))
-        is_match = 1;
+      json_stream_row(&js, matches[i]->id, matches[i]->name, matches[i]->age,
+                      matches[i]->department, matches[i]->salary);
     }
 
-    // CHECK 5: Salary (Int -> String)
-    if (!is_match)
+    // Linear Search through the WHOLE table
+    for (size_t k = 0; cols != NULL && k < cols->rows; k++)
     {
-      snprintf(temp_buf, sizeof(temp_buf), "%d", curr->salary);
-      if (strstr(temp_buf, query_str))
-        is_match = 1;
+      size_t i = column_row(t, cols, k);
+      if (column_row_matches(cols, i, &needle))
+        json_stream_row(&js, cols->id[i], columns_name(cols, i), cols->age[i],
+                        columns_department(cols, i), cols->salary[i]);
     }
+    page_stream_close(&js, &page, 0, 0, 0, t->epoch, t->version);
+  }
+
+  json_stream_end(&js);
+
+  // unlock the list
+  pthread_rwlock_unlock(&t->lock);
+  release_table(t);
+  free(matches);
+  free(found.ids);
+}
+
+// --- Handles Range Query (min <= age/salary <= max, via the sorted index) ---
+void handle_range(struct mg_connection *c, struct mg_http_message *hm)
+{
+  char field[16], min_str[32], max_str[32], table_id_str[32], owner_id_str[32];
+
+  if (mg_http_get_var(&hm->query, "table_id", table_id_str, sizeof(table_id_str)) <= 0 ||
+      mg_http_get_var(&hm->query, "owner_id", owner_id_str, sizeof(owner_id_str)) <= 0 ||
+      mg_http_get_var(&hm->query, "field", field, sizeof(field)) <= 0)
+  {
+    mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Missing params\" }");
+    return;
+  }
+
+  if (strcmp(field, "age") != 0 && strcmp(field, "salary") != 0)
+  {
+    mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
+                  "{ \"error\": \"Field must be 'age' or 'salary'\" }");
+    return;
+  }
+
+  // Either bound may be left out
+  int min = INT_MIN, max = INT_MAX;
+  if (mg_http_get_var(&hm->query, "min", min_str, sizeof(min_str)) > 0) min = atoi(min_str);
+  if (mg_http_get_var(&hm->query, "max", max_str, sizeof(max_str)) > 0) max = atoi(max_str);
+
+  int load_status;
+  Table *t = get_or_load_table(atoi(table_id_str), atoi(owner_id_str), &load_status);
+  if (!t)
+  {
+    mg_http_reply(c, load_status, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"%s\" }", table_error_text(load_status));
+    return;
+  }
+
+  pthread_rwlock_rdlock(&t->lock);
+
+  RangeIndex *ri = table_range_index(t, field);
+  if (!ri)
+  {
+    pthread_rwlock_unlock(&t->lock);
+    release_table(t);
+    mg_http_reply(c, 500, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Server Memory Error\" }");
+    return;
+  }
+
+  // Rows come out ordered by the field (ties by id)
+  RangeCursor cursor;
+  range_index_seek(ri, min, max, &cursor);
+
+  JsonStream js;
+  json_stream_begin(&js, c, NULL);
+  json_stream_text(&js, "[");
 
-    // 5. If Match Found -> Add to Array
-    if (is_match)
+  int id;
+  while (range_cursor_next(&cursor, &id))
+  {
+    emp *node = find_node_by_id(t, id);
+    if (node)
     {
-      cJSON *emp_obj = cJSON_CreateObject();
-      cJSON_AddNumberToObject(emp_obj, "id", curr->id);
-      cJSON_AddStringToObject(emp_obj, "name", curr->name);
-      cJSON_AddNumberToObject(emp_obj, "age", curr->age);
-      cJSON_AddStringToObject(emp_obj, "department", curr->department);
-      cJSON_AddNumberToObject(emp_obj, "salary", curr->salary);
-
-      cJSON_AddItemToArray(results_array, emp_obj);
-      match_count++;
+      json_stream_row(&js, node->id, node->name, node->age, node->department, node->salary);
     }
+  }
+
+  json_stream_text(&js, "]");
+  json_stream_end(&js);
+
+  pthread_rwlock_unlock(&t->lock);
+  release_table(t);
+}
+
+// --- HELPER: Order departments by name for a stable reply ---
+static int compare_dept_names(const void *a, const void *b)
+{
+  return strcmp((*(const DeptStats *const *)a)->name, (*(const DeptStats *const *)b)->name);
+}
 
-    curr = curr->next;
+// --- Per-department headcount, salary and age statistics ---
+void handle_aggregates(struct mg_connection *c, struct mg_http_message *hm)
+{
+  char table_id_str[32], owner_id_str[32];
+
+  if (mg_http_get_var(&hm->query, "table_id", table_id_str, sizeof(table_id_str)) <= 0 ||
+      mg_http_get_var(&hm->query, "owner_id", owner_id_str, sizeof(owner_id_str)) <= 0)
+  {
+    mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Missing params\" }");
+    return;
   }
 
-  // unlock the list
-  pthread_mutex_unlock(&t->lock);
+  int load_status;
+  Table *t = get_or_load_table(atoi(table_id_str), atoi(owner_id_str), &load_status);
+  if (!t)
+  {
+    mg_http_reply(c, load_status, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"%s\" }", table_error_text(load_status));
+    return;
+  }
+
+  pthread_rwlock_rdlock(&t->lock);
+
+  DeptAggregates *agg = table_dept_stats(t);
+  const DeptStats **depts = agg ? (const DeptStats **)malloc((agg->used + 1) * sizeof(DeptStats *)) : NULL;
+  if (!depts)
+  {
+    pthread_rwlock_unlock(&t->lock);
+    release_table(t);
+    mg_http_reply(c, 500, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Server Memory Error\" }");
+    return;
+  }
+
+  size_t n = 0;
+  for (size_t i = 0; i < agg->capacity; i++)
+  {
+    if (agg->slots[i].taken && agg->slots[i].count > 0)
+      depts[n++] = &agg->slots[i];
+  }
+  qsort(depts, n, sizeof(DeptStats *), compare_dept_names);
 
-  // Response
-  char *response_str = cJSON_PrintUnformatted(results_array);
-  mg_http_reply(c, 200, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "%s", response_str);
+  // One object per department with rows
+  cJSON *arr = cJSON_CreateArray();
+  for (size_t i = 0; i < n; i++)
+  {
+    const DeptStats *d = depts[i];
+    cJSON *obj = cJSON_CreateObject();
+    cJSON_AddStringToObject(obj, "department", d->name);
+    cJSON_AddNumberToObject(obj, "headcount", (double)d->count);
+    cJSON_AddNumberToObject(obj, "total_salary", (double)d->salary_sum);
+    cJSON_AddNumberToObject(obj, "avg_salary", (double)d->salary_sum / d->count);
+
+    int min = 0, max = 0;
+    agg_salary_bounds(d, &min, &max);
+    cJSON_AddNumberToObject(obj, "min_salary", min);
+    cJSON_AddNumberToObject(obj, "max_salary", max);
+    cJSON_AddNumberToObject(obj, "avg_age", (double)d->age_sum / d->count);
+
+    // Age histogram by decade, empty buckets left out
+    cJSON *ages = cJSON_AddObjectToObject(obj, "age_distribution");
+    for (int b = 0; b < AGG_AGE_BUCKETS; b++)
+    {
+      if (d->age_buckets[b] == 0)
+        continue;
+      char label[16];
+      if (b == AGG_AGE_BUCKETS - 1)
+        snprintf(label, sizeof(label), "%d+", b * 10);
+      else
+        snprintf(label, sizeof(label), "%d-%d", b * 10, b * 10 + 9);
+      cJSON_AddNumberToObject(ages, label, (double)d->age_buckets[b]);
+    }
+    cJSON_AddItemToArray(arr, obj);
+  }
+
+  pthread_rwlock_unlock(&t->lock);
+  release_table(t);
+  free(depts);
 
-  // Cleanup
+  char *response_str = cJSON_PrintUnformatted(arr);
+  mg_http_reply(c, 200, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "%s",
+                response_str ? response_str : "[]");
   free(response_str);
-  cJSON_Delete(results_array);
+  cJSON_Delete(arr);
 }
 
-// --- Handles Deletion (Removes a node by ID and frees its memory) ---
-void handle_delete(struct mg_connection *c, struct mg_http_message *hm)
+// --- Handles Delta Sync: every change since the client's table version ---
+// { "version": V, "full_resync": false, "changes": [
+//     { "op": "insert", "position": P, "row": {...} } | { "op": "delete", "id": N } | { "op": "reverse" } ] }
+// or { "version": V, "full_resync": true } once 'since' is out of reach
+void handle_changes(struct mg_connection *c, struct mg_http_message *hm)
 {
-  char id_str[32], table_id_str[32], owner_id_str[32];
+  char since_str[32], epoch_str[32], table_id_str[32], owner_id_str[32];
 
-  if (mg_http_get_var(&hm->query, "id", id_str, sizeof(id_str)) <= 0 ||
-      mg_http_get_var(&hm->query, "table_id", table_id_str, sizeof(table_id_str)) <= 0 ||
-      mg_http_get_var(&hm->query, "owner_id", owner_id_str, sizeof(owner_id_str)) <= 0)
+  if (mg_http_get_var(&hm->query, "table_id", table_id_str, sizeof(table_id_str)) <= 0 ||
+      mg_http_get_var(&hm->query, "owner_id", owner_id_str, sizeof(owner_id_str)) <= 0 ||
+      mg_http_get_var(&hm->query, "since", since_str, sizeof(since_str)) <= 0)
   {
     mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Missing params\" }");
     return;
   }
 
-  Table *t = get_or_load_table(atoi(table_id_str), atoi(owner_id_str));
+  char *end = NULL;
+  unsigned long long since = strtoull(since_str, &end, 10);
+  if (end == since_str || *end != '\0' || since_str[0] == '-')
+  {
+    mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Invalid 'since'\" }");
+    return;
+  }
+
+  // Versions are only comparable within one epoch; without it the client gets a full resync
+  unsigned long epoch = 0;
+  if (mg_http_get_var(&hm->query, "epoch", epoch_str, sizeof(epoch_str)) > 0)
+    epoch = strtoul(epoch_str, NULL, 10);
+
+  int load_status;
+  Table *t = get_or_load_table(atoi(table_id_str), atoi(owner_id_str), &load_status);
   if (!t)
   {
-    mg_http_reply(c, 403, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Access Denied\" }");
+    mg_http_reply(c, load_status, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"%s\" }", table_error_text(load_status));
     return;
   }
 
-  int target_id = atoi(id_str);
-  pthread_mutex_lock(&t->lock);
+  pthread_rwlock_rdlock(&t->lock);
+
+  // The first request starts the recording: it can only be answered if nothing changed
+  pthread_mutex_lock(&t->build_lock);
+  if (t->changes.entries == NULL && change_ring_start(&t->changes, t->version) == 0)
+    table_mark_changed(t);
+  pthread_mutex_unlock(&t->build_lock);
+  int covered = epoch == t->epoch &&
+                (since == t->version || change_ring_covers(&t->changes, since, t->version));
+
+  JsonStream js;
+  json_stream_begin(&js, c, NULL);
+
+  char text[112];
+  snprintf(text, sizeof(text), "{\"epoch\":%u,\"version\":%llu,\"full_resync\":%s", (unsigned)t->epoch,
+           (unsigned long long)t->version, covered ? "false,\"changes\":[" : "true");
+  json_stream_text(&js, text);
 
-  emp *curr = t->employeelist.head;
-  emp *prev = NULL;
+  for (uint64_t v = since + 1; covered && v <= t->version; v++)
+  {
+    const Change *ch = change_ring_get(&t->changes, v);
+    const char *sep = v > since + 1 ? "," : "";
+    if (ch->op == CHANGE_INSERT)
+    {
+      snprintf(text, sizeof(text), "%s{\"op\":\"insert\",\"position\":%d,\"row\":", sep, ch->position);
+      json_stream_text(&js, text);
+      json_stream_row(&js, ch->row.id, ch->row.name, ch->row.age, ch->row.department, ch->row.salary);
+      json_stream_text(&js, "}");
+    }
+    else if (ch->op == CHANGE_DELETE)
+    {
+      snprintf(text, sizeof(text), "%s{\"op\":\"delete\",\"id\":%d}", sep, ch->row.id);
+      json_stream_text(&js, text);
+    }
+    else
+    {
+      snprintf(text, sizeof(text), "%s{\"op\":\"reverse\"}", sep);
+      json_stream_text(&js, text);
+    }
+  }
 
-  if (curr && curr->id == target_id)
-  { // Head
-    t->employeelist.head = curr->next;
-    if (!t->employeelist.head)
-      t->employeelist.tail = NULL;
-    save_table_binary(t);
+  json_stream_text(&js, covered ? "]}" : "}");
+  json_stream_end(&js);
+  pthread_rwlock_unlock(&t->lock);
+  release_table(t);
+}
 
-    char log_details[64];
-    snprintf(log_details, sizeof(log_details), "Deleted Employee ID: %d", target_id);
-    add_log(atoi(owner_id_str), "DELETE", log_details);
+// --- Handles Deletion (Removes a node by ID and frees its memory) ---
+void handle_delete(struct mg_connection *c, struct mg_http_message *hm)
+{
+  char id_str[32], table_id_str[32], owner_id_str[32];
 
-    pthread_mutex_unlock(&t->lock);
-    free(curr);
-    mg_http_reply(c, 200, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"status\": \"Deleted\" }");
+  if (mg_http_get_var(&hm->query, "id", id_str, sizeof(id_str)) <= 0 ||
+      mg_http_get_var(&hm->query, "table_id", table_id_str, sizeof(table_id_str)) <= 0 ||
+      mg_http_get_var(&hm->query, "owner_id", owner_id_str, sizeof(owner_id_str)) <= 0)
+  {
+    mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Missing params\" }");
     return;
   }
 
-  while (curr && curr->id != target_id)
+  int load_status;
+  Table *t = get_or_load_table(atoi(table_id_str), atoi(owner_id_str), &load_status);
+  if (!t)
   {
-    prev = curr;
-    curr = curr->next;
+    mg_http_reply(c, load_status, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"%s\" }", table_error_text(load_status));
+    return;
   }
 
+  int target_id = atoi(id_str);
+  pthread_rwlock_wrlock(&t->lock);
+
+  emp *curr = detach_node_by_id(t, target_id);
   if (!curr)
   {
-    pthread_mutex_unlock(&t->lock);
+    pthread_rwlock_unlock(&t->lock);
+    release_table(t);
     mg_http_reply(c, 404, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"ID not found\" }");
     return;
   }
 
-  prev->next = curr->next;
-  if (curr == t->employeelist.tail)
-    t->employeelist.tail = prev;
-  save_table_binary(t);
+  int logged = wal_log_delete(t, target_id);
 
   char log_details[64];
   snprintf(log_details, sizeof(log_details), "Deleted Employee ID: %d", target_id);
   add_log(atoi(owner_id_str), "DELETE", log_details);
 
-  pthread_mutex_unlock(&t->lock);
-  free(curr);
+  free_node(t, curr);
+  pthread_rwlock_unlock(&t->lock);
+  release_table(t);
+  if (logged != 0)
+  {
+    mg_http_reply(c, 500, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"%s\" }", WAL_ERROR_TEXT);
+    return;
+  }
   mg_http_reply(c, 200, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"status\": \"Deleted\" }");
 }
 
@@ -332,36 +1025,34 @@ void handle_reverse(struct mg_connection *c, struct mg_http_message *hm)
   }
 
   // 2. Load Table using Integers
-  Table *t = get_or_load_table(atoi(table_id_str), atoi(owner_id_str));
+  int load_status;
+  Table *t = get_or_load_table(atoi(table_id_str), atoi(owner_id_str), &load_status);
   if (!t)
   {
-    mg_http_reply(c, 403, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
-                  "{ \"status\": \"Error\", \"message\": \"Access Denied or Table Not Found\" }");
+    mg_http_reply(c, load_status, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
+                  "{ \"status\": \"Error\", \"message\": \"%s\" }", table_error_text(load_status));
     return;
   }
 
-  // 3. Logic (Unchanged)
-  pthread_mutex_lock(&t->lock);
+  // 3. Logic: O(1) flip of the reading direction, logged as one WAL record
+  pthread_rwlock_wrlock(&t->lock);
 
-  emp *prev = NULL, *curr = t->employeelist.head, *next = NULL;
-  emp *old_head = t->employeelist.head;
-  while (curr != NULL)
-  {
-    next = curr->next;
-    curr->next = prev;
-    prev = curr;
-    curr = next;
-  }
-  t->employeelist.head = prev;
-  t->employeelist.tail = old_head;
+  reverse_list(t);
 
-  save_table_binary(t);
+  int logged = wal_log_reverse(t);
 
   char log_details[64];
   snprintf(log_details, sizeof(log_details), "Reversed Table ID: %d", t->id);
   add_log(atoi(owner_id_str), "UPDATE", log_details);
 
-  pthread_mutex_unlock(&t->lock);
+  pthread_rwlock_unlock(&t->lock);
+  release_table(t);
+
+  if (logged != 0)
+  {
+    mg_http_reply(c, 500, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{\"status\": \"Error\", \"message\": \"%s\"}", WAL_ERROR_TEXT);
+    return;
+  }
 
   mg_http_reply(c, 200, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{\"status\": \"Success\"}");
 }
@@ -381,33 +1072,55 @@ void handle_recursive_reverse(struct mg_connection *c, struct mg_http_message *h
   }
 
   // 2. Load Table
-  Table *t = get_or_load_table(atoi(table_id_str), atoi(owner_id_str));
+  int load_status;
+  Table *t = get_or_load_table(atoi(table_id_str), atoi(owner_id_str), &load_status);
   if (!t)
   {
-    mg_http_reply(c, 403, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
-                  "{ \"status\": \"Error\", \"message\": \"Access Denied or Table Not Found\" }");
+    mg_http_reply(c, load_status, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
+                  "{ \"status\": \"Error\", \"message\": \"%s\" }", table_error_text(load_status));
     return;
   }
 
-  cJSON *json_array = cJSON_CreateArray();
+  JsonStream js;
 
-  pthread_mutex_lock(&t->lock);
-  recursive_json_builder(t->employeelist.head, json_array);
-  pthread_mutex_unlock(&t->lock);
+  pthread_rwlock_rdlock(&t->lock);
 
-  char *response_str = cJSON_PrintUnformatted(json_array);
-  mg_http_reply(c, 200, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "%s", response_str);
+  // Nothing changed since the client's copy: no rows touched
+  char etag[ETAG_MAX], etag_header[ETAG_MAX + 16];
+  if (table_etag_matches(t, hm, etag, sizeof(etag)))
+  {
+    pthread_rwlock_unlock(&t->lock);
+    release_table(t);
+    reply_not_modified(c, etag);
+    return;
+  }
+  snprintf(etag_header, sizeof(etag_header), "ETag: %s\r\n", etag);
 
-  free(response_str);
-  cJSON_Delete(json_array);
+  // Copy under the lock, encode without it
+  FrozenTable *rows = table_freeze(t);
+  pthread_rwlock_unlock(&t->lock);
+  release_table(t);
+  if (!rows)
+  {
+    mg_http_reply(c, 500, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
+                  "{ \"status\": \"Error\", \"message\": \"Server Memory Error\" }");
+    return;
+  }
+
+  json_stream_begin(&js, c, etag_header);
+  json_stream_text(&js, "[");
+  reverse_json_builder(rows, &js);
+  json_stream_text(&js, "]");
+  json_stream_end(&js);
+  frozen_release(rows);
 }
 
 // --- Handle Update ---
 void handle_update(struct mg_connection *c, struct mg_http_message *hm)
 {
   // 1. Parse JSON Safely
-  cJSON *json = cJSON_ParseWithLength(hm->body.buf, hm->body.len);
-  if (!json)
+  EmployeePayload payload;
+  if (parse_employee_payload(hm->body.buf, hm->body.len, &payload) != 0)
   {
     mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
                   "{ \"status\": \"Error\", \"message\": \"Invalid JSON\" }");
@@ -415,141 +1128,100 @@ void handle_update(struct mg_connection *c, struct mg_http_message *hm)
   }
 
   // 2. Extract & Validate Meta Fields
-  cJSON *j_table_id = cJSON_GetObjectItem(json, "table_id");
-  cJSON *j_owner_id = cJSON_GetObjectItem(json, "owner_id");
-  cJSON *j_orig_id = cJSON_GetObjectItem(json, "original_id");
-  cJSON *j_pos = cJSON_GetObjectItem(json, "position");
-  cJSON *j_data = cJSON_GetObjectItem(json, "data");
-
-  if (!j_table_id || !cJSON_IsNumber(j_table_id) ||
-      !j_owner_id || !cJSON_IsNumber(j_owner_id) ||
-      !j_orig_id || !j_data)
+  if (payload.table_id.kind != FIELD_NUMBER ||
+      payload.owner_id.kind != FIELD_NUMBER ||
+      payload.original_id.kind == FIELD_MISSING || payload.data == FIELD_MISSING)
   {
     mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
                   "{ \"status\": \"Error\", \"message\": \"Missing required fields\" }");
-    cJSON_Delete(json);
     return;
   }
 
-  int original_id = j_orig_id->valueint;
-  int target_pos = j_pos ? j_pos->valueint : -1;
-
-  // 3. Extract & Validate Data Fields
-  cJSON *j_id = cJSON_GetObjectItem(j_data, "id");
-  cJSON *j_name = cJSON_GetObjectItem(j_data, "name");
-  cJSON *j_age = cJSON_GetObjectItem(j_data, "age");
-  cJSON *j_dept = cJSON_GetObjectItem(j_data, "department");
-  cJSON *j_salary = cJSON_GetObjectItem(j_data, "salary");
+  int original_id = payload.original_id.value;
+  int target_pos = payload.position.kind != FIELD_MISSING ? payload.position.value : -1;
 
-  // Check Types
-  if (!j_id || !cJSON_IsNumber(j_id) ||
-      !j_name || !cJSON_IsString(j_name) ||
-      !j_age || !cJSON_IsNumber(j_age) ||
-      !j_dept || !cJSON_IsString(j_dept) ||
-      !j_salary || !cJSON_IsNumber(j_salary))
+  // 3. Validate Data Fields: Check Types
+  if (payload.id.kind != FIELD_NUMBER ||
+      payload.name != FIELD_STRING ||
+      payload.age.kind != FIELD_NUMBER ||
+      payload.department != FIELD_STRING ||
+      payload.salary.kind != FIELD_NUMBER)
   {
     mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
                   "{ \"status\": \"Error\", \"message\": \"Data type mismatch\" }");
-    cJSON_Delete(json);
     return;
   }
 
   // 4. FIX: Use get_or_load_table with Integers
-  Table *t = get_or_load_table(j_table_id->valueint, j_owner_id->valueint);
+  int load_status;
+  Table *t = get_or_load_table(payload.table_id.value, payload.owner_id.value, &load_status);
   if (!t)
   {
-    mg_http_reply(c, 403, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
-                  "{ \"status\": \"Error\", \"message\": \"Access Denied or Table Not Found\" }");
-    cJSON_Delete(json);
+    mg_http_reply(c, load_status, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
+                  "{ \"status\": \"Error\", \"message\": \"%s\" }", table_error_text(load_status));
     return;
   }
 
-  // Create node
-  emp *new_node = create_node_from_json(j_data);
+  // --- CRITICAL SECTION STARTS ---
+  pthread_rwlock_wrlock(&t->lock);
+
+  // Create node (from the table's slabs, so only under its lock)
+  emp *new_node = record_to_node(&t->nodes, payload.record);
   if (!new_node)
   {
+    pthread_rwlock_unlock(&t->lock);
+    release_table(t);
     mg_http_reply(c, 500, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
                   "{ \"status\": \"Error\", \"message\": \"Server Memory Error\" }");
-    cJSON_Delete(json);
     return;
   }
 
-  // --- CRITICAL SECTION STARTS ---
-  pthread_mutex_lock(&t->lock);
-
   // 5. DATA LOGIC VALIDATION
   if (!isOnlyAlphaSpaces(new_node->name) || strlen(new_node->name) >= 50)
   {
-    pthread_mutex_unlock(&t->lock);
-    free(new_node);
-    cJSON_Delete(json);
+    free_node(t, new_node);
+    pthread_rwlock_unlock(&t->lock);
+    release_table(t);
     mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\n", "{ \"status\": \"Error\", \"message\": \"Invalid Name\" }");
     return;
   }
   if (!isOnlyAlphaSpaces(new_node->department))
   {
-    pthread_mutex_unlock(&t->lock);
-    free(new_node);
-    cJSON_Delete(json);
+    free_node(t, new_node);
+    pthread_rwlock_unlock(&t->lock);
+    release_table(t);
     mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\n", "{ \"status\": \"Error\", \"message\": \"Invalid Department\" }");
     return;
   }
   if (new_node->age < 18 || new_node->salary < 0)
   {
-    pthread_mutex_unlock(&t->lock);
-    free(new_node);
-    cJSON_Delete(json);
+    free_node(t, new_node);
+    pthread_rwlock_unlock(&t->lock);
+    release_table(t);
     mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\n", "{ \"status\": \"Error\", \"message\": \"Invalid Age or Salary\" }");
     return;
   }
 
   // 6. Collision Check (If changing ID)
-  if (new_node->id != original_id)
+  if (new_node->id != original_id && find_node_by_id(t, new_node->id) != NULL)
   {
-    emp *check = t->employeelist.head;
-    while (check)
-    {
-      if (check->id == new_node->id)
-      {
-        pthread_mutex_unlock(&t->lock);
-        free(new_node);
-        cJSON_Delete(json);
-        mg_http_reply(c, 409, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"status\": \"Error\", \"message\": \"New ID already exists\" }");
-        return;
-      }
-      check = check->next;
-    }
+    free_node(t, new_node);
+    pthread_rwlock_unlock(&t->lock);
+    release_table(t);
+    mg_http_reply(c, 409, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"status\": \"Error\", \"message\": \"New ID already exists\" }");
+    return;
   }
 
   // 7. FIND & DETACH OLD NODE
-  emp *curr = t->employeelist.head;
-  emp *prev = NULL;
-  int found = 0;
-  while (curr != NULL)
-  {
-    if (curr->id == original_id)
-    {
-      if (prev == NULL)
-        t->employeelist.head = curr->next;
-      else
-        prev->next = curr->next;
-
-      if (curr == t->employeelist.tail)
-        t->employeelist.tail = prev;
-
-      free(curr);
-      found = 1;
-      break;
-    }
-    prev = curr;
-    curr = curr->next;
-  }
+  emp *old_node = detach_node_by_id(t, original_id);
+  int found = old_node != NULL;
+  free_node(t, old_node);
 
   if (!found)
   {
-    pthread_mutex_unlock(&t->lock);
-    free(new_node);
-    cJSON_Delete(json);
+    free_node(t, new_node);
+    pthread_rwlock_unlock(&t->lock);
+    release_table(t);
     mg_http_reply(c, 404, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
                   "{ \"status\": \"Error\", \"message\": \"Original ID not found\" }");
     return;
@@ -558,16 +1230,319 @@ void handle_update(struct mg_connection *c, struct mg_http_message *hm)
   // 8. INSERT NEW NODE
   insert_node_at_pos(t, new_node, target_pos);
 
-  // 9. Save & Unlock
-  save_table_binary(t);
+  // 9. Log & Unlock
+  int logged = wal_log_update(t, original_id, new_node, target_pos);
 
   char log_details[128];
   snprintf(log_details, sizeof(log_details), "Updated Employee ID: %d", new_node->id);
-  add_log(j_owner_id->valueint, "UPDATE", log_details);
+  add_log(payload.owner_id.value, "UPDATE", log_details);
 
-  pthread_mutex_unlock(&t->lock);
+  pthread_rwlock_unlock(&t->lock);
+  release_table(t);
+
+  if (logged != 0)
+  {
+    mg_http_reply(c, 500, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
+                  "{ \"status\": \"Error\", \"message\": \"%s\" }", WAL_ERROR_TEXT);
+    return;
+  }
 
   mg_http_reply(c, 200, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
                 "{ \"status\": \"success\", \"message\": \"Employee Updated\" }");
+}
+
+// --- HELPER: One applied /batch operation and what it takes to undo it ---
+typedef struct {
+  const char *op;      // "insert" / "update" / "delete"
+  int id;              // Row the op produced or removed
+  emp *added;          // Node the op linked in (insert / update)
+  emp *removed;        // Node the op unlinked (update / delete), freed on commit
+  int removed_pos;     // Where 'removed' sat, so a rollback can put it back
+  WalRecord rec;       // Logged once the whole batch commits
+} BatchStep;
+
+// --- HELPER: Apply one /batch operation (call while holding t->lock) ---
+// Returns NULL on success, otherwise the error message and its HTTP status.
+static const char *batch_apply(Table *t, const cJSON *op, BatchStep *step, int *status)
+{
+  const cJSON *kind = cJSON_GetObjectItem(op, "op");
+  *status = 400;
+  if (!cJSON_IsString(kind) || kind->valuestring == NULL)
+    return "Missing 'op'";
+
+  if (strcmp(kind->valuestring, "delete") == 0)
+  {
+    step->op = "delete";
+    const cJSON *id = cJSON_GetObjectItem(op, "id");
+    if (!cJSON_IsNumber(id))
+      return "Missing/Invalid id";
+
+    emp *node = find_node_by_id(t, id->valueint);
+    if (node == NULL)
+    {
+      *status = 404;
+      return "ID not found";
+    }
+
+    step->id = node->id;
+    step->removed_pos = (int)table_row_rank(t, node);
+    detach_node(t, node);
+    step->removed = node;
+    WalRecord rec = {WAL_DELETE, node->id, -1, node_to_record(NULL)};
+    step->rec = rec;
+    return NULL;
+  }
+
+  EmployeePayload payload;
+  payload_from_json(op, &payload);
+  int position = payload.position.kind != FIELD_MISSING ? payload.position.value : -1;
+
+  if (strcmp(kind->valuestring, "insert") == 0)
+  {
+    step->op = "insert";
+    const char *error_msg = validate_employee_payload(&payload, t);
+    if (error_msg != NULL)
+      return error_msg;
+
+    emp *node = record_to_node(&t->nodes, payload.record);
+    if (node == NULL)
+    {
+      *status = 500;
+      return "Memory Error";
+    }
+
+    insert_node_at_pos(t, node, position);
+    step->id = node->id;
+    step->added = node;
+    WalRecord rec = {WAL_INSERT, 0, position, node_to_record(node)};
+    step->rec = rec;
+    return NULL;
+  }
+
+  if (strcmp(kind->valuestring, "update") == 0)
+  {
+    // Same checks as /update
+    step->op = "update";
+    if (payload.original_id.kind == FIELD_MISSING || payload.data == FIELD_MISSING)
+      return "Missing required fields";
+    if (payload.id.kind != FIELD_NUMBER || payload.name != FIELD_STRING || payload.age.kind != FIELD_NUMBER ||
+        payload.department != FIELD_STRING || payload.salary.kind != FIELD_NUMBER)
+      return "Data type mismatch";
+    if (!payload.name_alpha || payload.name_len >= 50)
+      return "Invalid Name";
+    if (!payload.dept_alpha)
+      return "Invalid Department";
+    if (payload.age.value < 18 || payload.salary.value < 0)
+      return "Invalid Age or Salary";
+
+    int original_id = payload.original_id.value;
+    if (payload.id.value != original_id && find_node_by_id(t, payload.id.value) != NULL)
+    {
+      *status = 409;
+      return "New ID already exists";
+    }
+
+    emp *old_node = find_node_by_id(t, original_id);
+    if (old_node == NULL)
+    {
+      *status = 404;
+      return "Original ID not found";
+    }
+
+    emp *new_node = record_to_node(&t->nodes, payload.record);
+    if (new_node == NULL)
+    {
+      *status = 500;
+      return "Server Memory Error";
+    }
+
+    step->removed_pos = (int)table_row_rank(t, old_node);
+    detach_node(t, old_node);
+    insert_node_at_pos(t, new_node, position);
+    step->id = new_node->id;
+    step->added = new_node;
+    step->removed = old_node;
+    WalRecord rec = {WAL_UPDATE, original_id, position, node_to_record(new_node)};
+    step->rec = rec;
+    return NULL;
+  }
+
+  return "Unknown op (expected insert, update or delete)";
+}
+
+// --- HELPER: Undo applied /batch operations, newest first ---
+// 'version' is the table version before the batch: nothing was logged, so
+// the version bumps of the applied ops and their undo must not survive either.
+static void batch_rollback(Table *t, BatchStep *steps, int count, uint64_t version)
+{
+  for (int i = count - 1; i >= 0; i--)
+  {
+    if (steps[i].added)
+    {
+      detach_node(t, steps[i].added);
+      free_node(t, steps[i].added);
+    }
+    if (steps[i].removed)
+    {
+      insert_node_at_pos(t, steps[i].removed, steps[i].removed_pos);
+    }
+  }
+  change_ring_rewind(&t->changes, version, t->version);
+  t->version = version;
+}
+
+// --- Handle Batch: many insert / update / delete ops, all or nothing ---
+// Body: { table_id, owner_id, ops: [ { op: "insert", position?, data },
+//                                    { op: "update", original_id, position?, data },
+//                                    { op: "delete", id } ] }
+void handle_batch(struct mg_connection *c, struct mg_http_message *hm)
+{
+  cJSON *json = cJSON_ParseWithLength(hm->body.buf, hm->body.len);
+  if (!json)
+  {
+    mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Invalid JSON\" }");
+    return;
+  }
+
+  cJSON *table_id = cJSON_GetObjectItem(json, "table_id");
+  cJSON *owner_id = cJSON_GetObjectItem(json, "owner_id");
+  cJSON *ops = cJSON_GetObjectItem(json, "ops");
+  if (!cJSON_IsNumber(table_id) || !cJSON_IsNumber(owner_id) || !cJSON_IsArray(ops))
+  {
+    cJSON_Delete(json);
+    mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Missing/Invalid table_id, owner_id or ops\" }");
+    return;
+  }
+
+  int count = cJSON_GetArraySize(ops);
+  if (count == 0 || count > WAL_BATCH_MAX_RECORDS)
+  {
+    cJSON_Delete(json);
+    mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
+                  "{ \"error\": \"A batch holds 1 to %d operations\" }", WAL_BATCH_MAX_RECORDS);
+    return;
+  }
+
+  int load_status;
+  Table *t = get_or_load_table(table_id->valueint, owner_id->valueint, &load_status);
+  if (!t)
+  {
+    cJSON_Delete(json);
+    mg_http_reply(c, load_status, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"%s\" }", table_error_text(load_status));
+    return;
+  }
+
+  BatchStep *steps = (BatchStep *)calloc(count, sizeof(BatchStep));
+  if (!steps)
+  {
+    release_table(t);
+    cJSON_Delete(json);
+    mg_http_reply(c, 500, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"error\": \"Memory Error\" }");
+    return;
+  }
+
+  // --- CRITICAL SECTION: every op, then one log write ---
+  pthread_rwlock_wrlock(&t->lock);
+
+  uint64_t version_before = t->version;
+  int applied = 0, status = 200, op_status;
+  const char *error_msg = NULL;
+  const cJSON *op;
+  cJSON_ArrayForEach(op, ops)
+  {
+    error_msg = batch_apply(t, op, &steps[applied], &op_status);
+    if (error_msg != NULL)
+    {
+      status = op_status;
+      break;
+    }
+    applied++;
+  }
+
+  int inserted = 0, updated = 0, deleted = 0;
+  if (error_msg != NULL)
+  {
+    batch_rollback(t, steps, applied, version_before);
+  }
+  else
+  {
+    WalRecord *records = (WalRecord *)malloc(count * sizeof(WalRecord));
+    for (int i = 0; i < count; i++)
+    {
+      if (records)
+        records[i] = steps[i].rec;
+      free_node(t, steps[i].removed);
+      inserted += steps[i].rec.op == WAL_INSERT;
+      updated += steps[i].rec.op == WAL_UPDATE;
+      deleted += steps[i].rec.op == WAL_DELETE;
+    }
+
+    int logged = records ? wal_log_batch(t, records, count)
+                         : checkpoint_table(t); // No room to frame the log records: snapshot instead
+    free(records);
+    if (logged != 0)
+      status = 500;
+
+    char log_details[128];
+    snprintf(log_details, sizeof(log_details), "Batch of %d: %d inserted, %d updated, %d deleted",
+             count, inserted, updated, deleted);
+    add_log(owner_id->valueint, "BATCH", log_details);
+  }
+
+  pthread_rwlock_unlock(&t->lock);
+  release_table(t);
+
+  // Per-op report (built outside the lock)
+  cJSON *reply = cJSON_CreateObject();
+  cJSON *results = cJSON_AddArrayToObject(reply, "results");
+  for (int i = 0; i < count; i++)
+  {
+    cJSON *item = cJSON_CreateObject();
+    cJSON_AddNumberToObject(item, "index", i);
+    if (i < applied)
+    {
+      cJSON_AddStringToObject(item, "op", steps[i].op);
+      cJSON_AddNumberToObject(item, "id", steps[i].id);
+      cJSON_AddStringToObject(item, "status", error_msg ? "rolled_back" : "ok");
+    }
+    else if (i == applied)
+    {
+      if (steps[i].op)
+        cJSON_AddStringToObject(item, "op", steps[i].op);
+      cJSON_AddStringToObject(item, "status", "error");
+      cJSON_AddStringToObject(item, "message", error_msg);
+    }
+    else
+    {
+      cJSON_AddStringToObject(item, "status", "skipped");
+    }
+    cJSON_AddItemToArray(results, item);
+  }
+
+  if (error_msg)
+  {
+    cJSON_AddStringToObject(reply, "status", "Error");
+    cJSON_AddStringToObject(reply, "message", "Batch rolled back, nothing was applied");
+    cJSON_AddNumberToObject(reply, "failed_index", applied);
+  }
+  else if (status != 200)
+  {
+    cJSON_AddStringToObject(reply, "status", "Error");
+    cJSON_AddStringToObject(reply, "message", WAL_ERROR_TEXT);
+  }
+  else
+  {
+    cJSON_AddStringToObject(reply, "status", "success");
+    cJSON_AddNumberToObject(reply, "inserted", inserted);
+    cJSON_AddNumberToObject(reply, "updated", updated);
+    cJSON_AddNumberToObject(reply, "deleted", deleted);
+  }
+
+  char *reply_str = cJSON_PrintUnformatted(reply);
+  mg_http_reply(c, status, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "%s",
+                reply_str ? reply_str : "{}");
+  free(reply_str);
+  cJSON_Delete(reply);
+  free(steps);
   cJSON_Delete(json);
 }
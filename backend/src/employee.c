@@ -9,50 +9,26 @@ void init_employee_list(EmployeeList *list)
   {
     list->head = NULL;
     list->tail = NULL;
+    list->reversed = 0;
   }
 }
 
-// --- Create Node from JSON ---
-emp *create_node_from_json(cJSON *json)
+emp *list_first(const EmployeeList *list)
 {
-  if (!json) return NULL; // Safety check
-
-  // Alloting Memory space for new node
-  emp *new_node = (emp *)calloc(1, sizeof(emp));
-  if (!new_node)
-    return NULL;
+  return list->reversed ? list->tail : list->head;
+}
 
-  // Extract fields safely from JSON
-  cJSON *j_id = cJSON_GetObjectItem(json, "id");
-  cJSON *j_name = cJSON_GetObjectItem(json, "name");
-  cJSON *j_age = cJSON_GetObjectItem(json, "age");
-  cJSON *j_dept = cJSON_GetObjectItem(json, "department");
-  cJSON *j_salary = cJSON_GetObjectItem(json, "salary");
+emp *list_last(const EmployeeList *list)
+{
+  return list->reversed ? list->head : list->tail;
+}
 
-  // Assigning values (Safely!)
-  // We use 'valueint' for numbers and check 'valuestring' for strings
-  if (j_id) {
-    new_node->id = j_id->valueint;
-  }
-  
-  if (j_name && j_name->valuestring) { // Check valuestring is not NULL
-    strncpy(new_node->name, j_name->valuestring, 49);
-    new_node->name[49] = '\0'; // Ensure null-termination
-  }
-  
-  if (j_age) {
-    new_node->age = j_age->valueint;
-  }
-  
-  if (j_dept && j_dept->valuestring) { // Check valuestring is not NULL
-    strncpy(new_node->department, j_dept->valuestring, 49);
-    new_node->department[49] = '\0';
-  }
-  
-  if (j_salary) {
-    new_node->salary = j_salary->valueint;
-  }
+emp *list_next(const EmployeeList *list, const emp *node)
+{
+  return list->reversed ? node->prev : node->next;
+}
 
-  new_node->next = NULL;
-  return new_node;
-}
\ No newline at end of file
+emp *list_prev(const EmployeeList *list, const emp *node)
+{
+  return list->reversed ? node->next : node->prev;
+}
@@ -23,57 +23,100 @@ void handle_export(struct mg_connection *c, struct mg_http_message *hm)
   }
 
   // 2. Load Table
-  Table *t = get_or_load_table(atoi(table_id_str), atoi(owner_id_str));
+  int load_status;
+  Table *t = get_or_load_table(atoi(table_id_str), atoi(owner_id_str), &load_status);
   if (!t)
   {
-    mg_http_reply(c, 403, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
-                  "{ \"status\": \"Error\", \"message\": \"Access Denied or Table Not Found\" }");
+    mg_http_reply(c, load_status, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
+                  "{ \"status\": \"Error\", \"message\": \"%s\" }", table_error_text(load_status));
     return;
   }
 
-  // 3. Prepare Headers
+  // 3. Lock first: the ETag has to describe exactly the rows we send
+  pthread_rwlock_rdlock(&t->lock);
+
+  char etag[ETAG_MAX];
+  if (table_etag_matches(t, hm, etag, sizeof(etag)))
+  {
+    pthread_rwlock_unlock(&t->lock);
+    release_table(t);
+    reply_not_modified(c, etag);
+    return;
+  }
+
+  // Copy the rows and let go: writers don't wait for the CSV to be formatted
+  FrozenTable *rows = table_freeze(t);
+  int table_id = t->id;
+  pthread_rwlock_unlock(&t->lock);
+  release_table(t);
+  if (!rows)
+  {
+    mg_http_reply(c, 500, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
+                  "{ \"status\": \"Error\", \"message\": \"Server Memory Error\" }");
+    return;
+  }
+
+  // 4. Prepare Headers
   char header_buffer[512];
   snprintf(header_buffer, sizeof(header_buffer),
            "HTTP/1.1 200 OK\r\n"
            "Content-Type: text/csv\r\n"
            "Content-Disposition: attachment; filename=\"%d_data.csv\"\r\n" // Use %d for int ID
            "Access-Control-Allow-Origin: *\r\n"
+           "ETag: %s\r\n"
            "Connection: close\r\n"
            "\r\n",
-           t->id);
+           table_id, etag);
 
   mg_send(c, header_buffer, strlen(header_buffer));
 
   char *csv_header_row = "ID,Name,Age,Department,Salary\n";
   mg_send(c, csv_header_row, strlen(csv_header_row));
 
-  // 4. Stream Data
-  pthread_mutex_lock(&t->lock);
+  // 5. Stream Data
 
   char log_details[64];
-  snprintf(log_details, sizeof(log_details), "Downloaded Table ID: %d", t->id);
+  snprintf(log_details, sizeof(log_details), "Downloaded Table ID: %d", table_id);
   add_log(atoi(owner_id_str), "EXPORT", log_details);
 
-  emp *curr = t->employeelist.head;
   char buffer[1024];
 
-  while (curr != NULL)
+  for (size_t i = 0; i < rows->count; i++)
   {
-    int line_len = snprintf(buffer, sizeof(buffer), "%d,%s,%d,%s,%d\n",
-                            curr->id, curr->name, curr->age, curr->department, curr->salary);
+    const EmployeeRecord *r = &rows->rows[i];
+    int line_len = snprintf(buffer, sizeof(buffer), "%d,%.*s,%d,%.*s,%d\n",
+                            r->id, (int)sizeof(r->name), r->name, r->age,
+                            (int)sizeof(r->department), r->department, r->salary);
 
     // Safety check for truncation
     if (line_len > 0 && (size_t)line_len < sizeof(buffer))
     {
       mg_send(c, buffer, line_len);
     }
-    curr = curr->next;
   }
 
-  pthread_mutex_unlock(&t->lock);
+  frozen_release(rows);
   c->is_draining = 1; // Close connection after download
 }
 
+// --- HELPER: Queue an imported row for the import's one log batch (-1 if out of memory) ---
+static int push_import_record(WalRecord **records, int *capacity, int count, emp *node)
+{
+  if (count == *capacity)
+  {
+    int grown_capacity = *capacity ? *capacity * 2 : 1024;
+    WalRecord *grown = (WalRecord *)realloc(*records, grown_capacity * sizeof(WalRecord));
+    if (!grown)
+      return -1;
+    *records = grown;
+    *capacity = grown_capacity;
+  }
+
+  WalRecord rec = {WAL_INSERT, 0, -1, node_to_record(node)};
+  (*records)[count] = rec;
+  return 0;
+}
+
 // --- Handle CSV Import ---
 void handle_import(struct mg_connection *c, struct mg_http_message *hm)
 {
@@ -89,17 +132,19 @@ void handle_import(struct mg_connection *c, struct mg_http_message *hm)
   }
 
   // 2. Load Table
-  Table *t = get_or_load_table(atoi(table_id_str), atoi(owner_id_str));
+  int load_status;
+  Table *t = get_or_load_table(atoi(table_id_str), atoi(owner_id_str), &load_status);
   if (!t)
   {
-    mg_http_reply(c, 403, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
-                  "{ \"status\": \"Error\", \"message\": \"Access Denied or Table Not Found\" }");
+    mg_http_reply(c, load_status, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
+                  "{ \"status\": \"Error\", \"message\": \"%s\" }", table_error_text(load_status));
     return;
   }
 
   // 3. Safety Checks
   if (hm->body.len == 0 || hm->body.buf == NULL)
   {
+    release_table(t);
     mg_http_reply(c, 400, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"status\": \"Error\", \"message\": \"Empty CSV Body\" }");
     return;
   }
@@ -107,6 +152,7 @@ void handle_import(struct mg_connection *c, struct mg_http_message *hm)
   char *csv_content = malloc(hm->body.len + 1);
   if (!csv_content)
   {
+    release_table(t);
     mg_http_reply(c, 500, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n", "{ \"status\": \"Error\", \"message\": \"Server Memory Error\" }");
     return;
   }
@@ -114,13 +160,15 @@ void handle_import(struct mg_connection *c, struct mg_http_message *hm)
   memcpy(csv_content, hm->body.buf, hm->body.len);
   csv_content[hm->body.len] = '\0';
 
-  pthread_mutex_lock(&t->lock);
+  pthread_rwlock_wrlock(&t->lock);
 
   // 4. Parse Logic
   char *cursor = csv_content;
   char *line_start = cursor;
   int count = 0;
   int skipped = 0;
+  WalRecord *records = NULL; // Logged together once parsing is done
+  int capacity = 0, log_ok = 1;
 
   while (*cursor != '\0')
   {
@@ -145,8 +193,16 @@ void handle_import(struct mg_connection *c, struct mg_http_message *hm)
         const char *error_msg = validate_core_logic(t, id, name, age, dept, salary);
         if (error_msg == NULL)
         {
-          append_to_list(t, id, name, age, dept, salary);
-          count++;
+          emp *added = append_to_list(t, id, name, age, dept, salary);
+          if (added)
+          {
+            // Past what one batch record may hold (or out of memory): snapshot instead (below)
+            if (log_ok && (count >= WAL_BATCH_MAX_RECORDS || push_import_record(&records, &capacity, count, added) != 0))
+              log_ok = 0;
+            count++;
+          }
+          else
+            skipped++;
         }
         else
           skipped++;
@@ -159,16 +215,27 @@ void handle_import(struct mg_connection *c, struct mg_http_message *hm)
     cursor = line_start;
   }
 
-  save_table_binary(t);
+  // 5. One log write (and one fsync in sync mode) for the whole file
+  int logged = 0;
+  if (count > 0)
+    logged = log_ok ? wal_log_batch(t, records, count) : checkpoint_table(t);
+  free(records);
 
   char log_details[128];
   snprintf(log_details, sizeof(log_details), "Imported CSV: Added %d, Skipped %d", count, skipped);
   add_log(atoi(owner_id_str), "IMPORT", log_details);
 
-  pthread_mutex_unlock(&t->lock);
+  pthread_rwlock_unlock(&t->lock);
+  release_table(t);
 
   free(csv_content);
 
+  if (logged != 0)
+  {
+    mg_http_reply(c, 500, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
+                  "{ \"status\": \"Error\", \"message\": \"%s\" }", WAL_ERROR_TEXT);
+    return;
+  }
   mg_http_reply(c, 200, "Access-Control-Allow-Origin: *\r\nContent-Type: application/json\r\n",
                 "{ \"status\": \"Success\", \"added\": %d, \"skipped\": %d }", count, skipped);
 }
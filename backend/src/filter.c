@@ -0,0 +1,459 @@
+// File_Name filter.c
+// Parser, compiler and evaluator for structured /search filters
+
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <strings.h>
+
+#include "filter.h"
+
+#define FILTER_MAX_DEPTH 32     // Nested NOT / parentheses
+
+static const char *const FIELD_NAMES[] = {"id", "name", "age", "department", "salary"};
+
+typedef enum {
+    TOK_END,
+    TOK_WORD,
+    TOK_NUMBER,
+    TOK_STRING,                 // start/len exclude the quotes
+    TOK_OP,
+    TOK_LPAREN,
+    TOK_RPAREN,
+    TOK_BAD
+} TokenKind;
+
+typedef struct {
+    int kind;
+    size_t start;
+    size_t len;
+} Token;
+
+typedef struct {
+    const char *src;
+    size_t pos;
+    int depth;
+    FilterProgram *prog;
+    const char *error;
+    size_t error_pos;
+} Parser;
+
+// --- LEXER ---
+
+static void read_token(const Parser *p, size_t *pos, Token *tok)
+{
+    const char *s = p->src;
+    size_t i = *pos;
+    while (isspace((unsigned char)s[i]))
+        i++;
+
+    tok->start = i;
+    tok->len = 1;
+    char ch = s[i];
+
+    if (ch == '\0')
+    {
+        tok->kind = TOK_END;
+        tok->len = 0;
+    }
+    else if (ch == '(' || ch == ')')
+    {
+        tok->kind = ch == '(' ? TOK_LPAREN : TOK_RPAREN;
+    }
+    else if (isalpha((unsigned char)ch) || ch == '_')
+    {
+        tok->kind = TOK_WORD;
+        while (isalnum((unsigned char)s[i + tok->len]) || s[i + tok->len] == '_')
+            tok->len++;
+    }
+    else if (isdigit((unsigned char)ch) || (ch == '-' && isdigit((unsigned char)s[i + 1])))
+    {
+        tok->kind = TOK_NUMBER;
+        while (isdigit((unsigned char)s[i + tok->len]))
+            tok->len++;
+    }
+    else if (ch == '"' || ch == '\'')
+    {
+        const char *close = strchr(s + i + 1, ch);
+        if (close == NULL)
+        {
+            tok->kind = TOK_BAD;
+        }
+        else
+        {
+            tok->kind = TOK_STRING;
+            tok->start = i + 1;
+            tok->len = (size_t)(close - (s + i + 1));
+            i += 2; // Quotes are consumed below along with the text
+        }
+    }
+    else if (ch == '=' || ch == '!' || ch == '<' || ch == '>')
+    {
+        tok->kind = TOK_OP;
+        char next = s[i + 1];
+        if (next == '=' || (ch == '<' && next == '>'))
+            tok->len = 2;
+        else if (ch == '!')
+            tok->kind = TOK_BAD;
+    }
+    else
+    {
+        tok->kind = TOK_BAD;
+    }
+
+    *pos = i + tok->len;
+}
+
+static void next_token(Parser *p, Token *tok)
+{
+    read_token(p, &p->pos, tok);
+}
+
+static void peek_token(const Parser *p, Token *tok)
+{
+    size_t pos = p->pos;
+    read_token(p, &pos, tok);
+}
+
+static int token_is(const Parser *p, const Token *tok, const char *word)
+{
+    return tok->kind == TOK_WORD && strlen(word) == tok->len && strncasecmp(p->src + tok->start, word, tok->len) == 0;
+}
+
+// Consume the next token if it is the keyword 'word'
+static int accept_word(Parser *p, const char *word)
+{
+    Token tok;
+    peek_token(p, &tok);
+    if (!token_is(p, &tok, word))
+        return 0;
+    next_token(p, &tok);
+    return 1;
+}
+
+// --- PARSER / COMPILER ---
+
+static int fail(Parser *p, const char *message, size_t pos)
+{
+    if (p->error == NULL)
+    {
+        p->error = message;
+        p->error_pos = pos;
+    }
+    return -1;
+}
+
+static FilterOp *emit(Parser *p, int kind)
+{
+    if (p->prog->count == FILTER_MAX_OPS)
+    {
+        fail(p, "Filter is too long", p->pos);
+        return NULL;
+    }
+    FilterOp *op = &p->prog->ops[p->prog->count++];
+    memset(op, 0, sizeof(*op));
+    op->kind = kind;
+    return op;
+}
+
+static int parse_cmp(const Parser *p, const Token *tok)
+{
+    if (token_is(p, tok, "CONTAINS"))
+        return CMP_CONTAINS;
+    if (tok->kind != TOK_OP)
+        return -1;
+
+    const char *s = p->src + tok->start;
+    if (tok->len == 1)
+        return s[0] == '=' ? CMP_EQ : s[0] == '<' ? CMP_LT : CMP_GT;
+    if (s[0] == '=')
+        return CMP_EQ;
+    if (s[0] == '!' || s[1] == '>')
+        return CMP_NE;
+    return s[0] == '<' ? CMP_LE : CMP_GE;
+}
+
+// field op value
+static int parse_comparison(Parser *p)
+{
+    Token tok;
+    next_token(p, &tok);
+
+    int field = -1;
+    for (int i = 0; i < (int)(sizeof(FIELD_NAMES) / sizeof(FIELD_NAMES[0])); i++)
+    {
+        if (token_is(p, &tok, FIELD_NAMES[i]))
+            field = i;
+    }
+    if (field < 0)
+        return fail(p, tok.kind == TOK_WORD ? "Unknown field" : "Expected a field name", tok.start);
+
+    next_token(p, &tok);
+    int cmp = parse_cmp(p, &tok);
+    if (cmp < 0)
+        return fail(p, "Expected a comparison", tok.start);
+
+    int is_text = field == FILTER_NAME || field == FILTER_DEPARTMENT;
+    if (cmp == CMP_CONTAINS && !is_text)
+        return fail(p, "CONTAINS only applies to name and department", tok.start);
+
+    next_token(p, &tok);
+    FilterOp *op = emit(p, FILTER_CMP);
+    if (op == NULL)
+        return -1;
+    op->field = field;
+    op->cmp = cmp;
+
+    if (is_text)
+    {
+        if (tok.kind != TOK_STRING)
+            return fail(p, "Expected a quoted string", tok.start);
+        if (tok.len >= NEEDLE_MAX)
+            return fail(p, "String is too long", tok.start);
+
+        char value[NEEDLE_MAX];
+        memcpy(value, p->src + tok.start, tok.len);
+        value[tok.len] = '\0';
+        needle_prepare(&op->text, value);
+        return 0;
+    }
+
+    if (tok.kind != TOK_NUMBER)
+        return fail(p, "Expected a number", tok.start);
+
+    errno = 0;
+    long value = strtol(p->src + tok.start, NULL, 10);
+    if (errno == ERANGE || value < INT_MIN || value > INT_MAX)
+        return fail(p, "Number is out of range", tok.start);
+    op->number = (int)value;
+    return 0;
+}
+
+static int parse_expr(Parser *p);
+
+// NOT factor | '(' expr ')' | comparison
+static int parse_factor(Parser *p)
+{
+    if (++p->depth > FILTER_MAX_DEPTH)
+        return fail(p, "Filter is nested too deeply", p->pos);
+
+    Token tok;
+    peek_token(p, &tok);
+
+    int rc;
+    if (accept_word(p, "NOT"))
+    {
+        rc = parse_factor(p);
+        if (rc == 0 && emit(p, FILTER_NOT) == NULL)
+            rc = -1;
+    }
+    else if (tok.kind == TOK_LPAREN)
+    {
+        next_token(p, &tok);
+        rc = parse_expr(p);
+        next_token(p, &tok);
+        if (rc == 0 && tok.kind != TOK_RPAREN)
+            rc = fail(p, "Expected ')'", tok.start);
+    }
+    else
+    {
+        rc = parse_comparison(p);
+    }
+
+    p->depth--;
+    return rc;
+}
+
+// factor (AND factor)*
+static int parse_term(Parser *p)
+{
+    if (parse_factor(p) != 0)
+        return -1;
+    while (accept_word(p, "AND"))
+    {
+        if (parse_factor(p) != 0 || emit(p, FILTER_AND) == NULL)
+            return -1;
+    }
+    return 0;
+}
+
+// term (OR term)*
+static int parse_expr(Parser *p)
+{
+    if (parse_term(p) != 0)
+        return -1;
+    while (accept_word(p, "OR"))
+    {
+        if (parse_term(p) != 0 || emit(p, FILTER_OR) == NULL)
+            return -1;
+    }
+    return 0;
+}
+
+int filter_compile(const char *src, FilterProgram *prog, const char **error, size_t *error_pos)
+{
+    Parser p = {src, 0, 0, prog, NULL, 0};
+    prog->count = 0;
+
+    if (parse_expr(&p) == 0)
+    {
+        Token tok;
+        next_token(&p, &tok);
+        if (tok.kind == TOK_END)
+            return 0;
+        fail(&p, "Unexpected text", tok.start);
+    }
+
+    *error = p.error;
+    *error_pos = p.error_pos;
+    return -1;
+}
+
+// --- EVALUATION ---
+
+static int compare_number(int cmp, int value, int target)
+{
+    switch (cmp)
+    {
+    case CMP_EQ: return value == target;
+    case CMP_NE: return value != target;
+    case CMP_LT: return value < target;
+    case CMP_LE: return value <= target;
+    case CMP_GT: return value > target;
+    default: return value >= target;
+    }
+}
+
+// 'hay' is NUL-terminated; 'len' saves the strlen
+static int compare_text(const FilterOp *op, const char *hay, size_t len)
+{
+    if (op->cmp == CMP_CONTAINS)
+        return needle_in_text(&op->text, hay, len);
+
+    if (op->cmp == CMP_EQ || op->cmp == CMP_NE)
+    {
+        int equal = len == op->text.len && strncasecmp(hay, op->text.lower, len) == 0;
+        return op->cmp == CMP_EQ ? equal : !equal;
+    }
+    return compare_number(op->cmp, strcasecmp(hay, op->text.lower), 0);
+}
+
+int filter_match(const FilterProgram *prog, const FilterRow *row)
+{
+    // Stack of results, one bit each, top at bit 0
+    uint64_t stack = 0;
+
+    for (int i = 0; i < prog->count; i++)
+    {
+        const FilterOp *op = &prog->ops[i];
+        uint64_t top;
+        switch (op->kind)
+        {
+        case FILTER_CMP:
+            switch (op->field)
+            {
+            case FILTER_ID: top = compare_number(op->cmp, row->id, op->number); break;
+            case FILTER_AGE: top = compare_number(op->cmp, row->age, op->number); break;
+            case FILTER_SALARY: top = compare_number(op->cmp, row->salary, op->number); break;
+            case FILTER_NAME: top = compare_text(op, row->name, row->name_len); break;
+            default: top = compare_text(op, row->department, row->dept_len); break;
+            }
+            stack = (stack << 1) | top;
+            break;
+        case FILTER_AND:
+            top = stack & 1;
+            stack = (stack >> 1) & (~(uint64_t)1 | top);
+            break;
+        case FILTER_OR:
+            top = stack & 1;
+            stack = (stack >> 1) | top;
+            break;
+        default:
+            stack ^= 1;
+            break;
+        }
+    }
+    return (int)(stack & 1);
+}
+
+// --- ACCESS PATH ---
+
+// Helper: first instruction of the subexpression that ends at 'end'
+static int subexpr_start(const FilterProgram *prog, int end)
+{
+    int need = 1;
+    for (int i = end; i >= 0; i--)
+    {
+        int kind = prog->ops[i].kind;
+        need += (kind == FILTER_AND || kind == FILTER_OR) ? 1 : (kind == FILTER_NOT ? 0 : -1);
+        if (need == 0)
+            return i;
+    }
+    return 0;
+}
+
+// Helper: intersect [*lo, *hi] with what 'cmp value' allows
+static void narrow(int *has, int *lo, int *hi, int cmp, int value)
+{
+    if (!*has)
+    {
+        *has = 1;
+        *lo = INT_MIN;
+        *hi = INT_MAX;
+    }
+
+    // Nothing is above INT_MAX or below INT_MIN: leave an empty range
+    if ((cmp == CMP_GT && value == INT_MAX) || (cmp == CMP_LT && value == INT_MIN))
+    {
+        *lo = 1;
+        *hi = 0;
+        return;
+    }
+
+    if (cmp == CMP_EQ || cmp == CMP_GE || cmp == CMP_GT)
+    {
+        int min = cmp == CMP_GT ? value + 1 : value;
+        *lo = min > *lo ? min : *lo;
+    }
+    if (cmp == CMP_EQ || cmp == CMP_LE || cmp == CMP_LT)
+    {
+        int max = cmp == CMP_LT ? value - 1 : value;
+        *hi = max < *hi ? max : *hi;
+    }
+}
+
+// Helper: note every comparison of the AND chain ending at 'end'
+static void collect_conjuncts(const FilterProgram *prog, int end, FilterPlan *plan)
+{
+    const FilterOp *op = &prog->ops[end];
+    if (op->kind == FILTER_AND)
+    {
+        collect_conjuncts(prog, end - 1, plan);
+        collect_conjuncts(prog, subexpr_start(prog, end - 1) - 1, plan);
+        return;
+    }
+    if (op->kind != FILTER_CMP || op->cmp == CMP_NE || op->cmp == CMP_CONTAINS)
+        return;
+
+    if (op->field == FILTER_ID && op->cmp == CMP_EQ && !plan->has_id)
+    {
+        plan->has_id = 1;
+        plan->id = op->number;
+    }
+    else if (op->field == FILTER_AGE)
+    {
+        narrow(&plan->has_age, &plan->age_min, &plan->age_max, op->cmp, op->number);
+    }
+    else if (op->field == FILTER_SALARY)
+    {
+        narrow(&plan->has_salary, &plan->salary_min, &plan->salary_max, op->cmp, op->number);
+    }
+}
+
+void filter_plan(const FilterProgram *prog, FilterPlan *plan)
+{
+    memset(plan, 0, sizeof(*plan));
+    if (prog->count > 0)
+        collect_conjuncts(prog, prog->count - 1, plan);
+}
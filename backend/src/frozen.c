@@ -0,0 +1,36 @@
+// File_Name frozen.c
+// Immutable, shared copies of a table's rows for long readers
+
+#include "frozen.h"
+
+FrozenTable *frozen_build(const EmployeeList *list, size_t count, uint64_t version)
+{
+    FrozenTable *f = (FrozenTable *)malloc(sizeof(FrozenTable) + (count + 1) * sizeof(EmployeeRecord));
+    if (f == NULL)
+        return NULL;
+
+    atomic_init(&f->refs, 1);
+    f->version = version;
+    f->count = 0;
+    for (const emp *curr = list_first(list); curr != NULL && f->count < count; curr = list_next(list, curr))
+    {
+        EmployeeRecord *r = &f->rows[f->count++];
+        r->id = curr->id;
+        r->age = curr->age;
+        r->salary = curr->salary;
+        memcpy(r->name, curr->name, sizeof(r->name));
+        memcpy(r->department, curr->department, sizeof(r->department));
+    }
+    return f;
+}
+
+void frozen_retain(FrozenTable *f)
+{
+    atomic_fetch_add(&f->refs, 1);
+}
+
+void frozen_release(FrozenTable *f)
+{
+    if (f != NULL && atomic_fetch_sub(&f->refs, 1) == 1)
+        free(f);
+}
@@ -0,0 +1,153 @@
+// File_Name index.c
+// Hash index from employee id to list node
+
+#include <stdint.h>
+
+#include "index.h"
+
+#define ID_INDEX_MIN_CAPACITY 64
+
+// Fibonacci hashing spreads sequential ids across the table. The mixing
+// ends up in the high bits, so the slot is taken from the top (like
+// bucket_of in table.c); the low bits of the product are as regular as the ids.
+static size_t id_hash(int id, size_t capacity)
+{
+    uint64_t h = (uint64_t)(uint32_t)id * 11400714819323198485ull;
+    return (size_t)(h >> (64 - __builtin_ctzll(capacity)));
+}
+
+void id_index_init(IdIndex *idx)
+{
+    idx->slots = NULL;
+    idx->capacity = 0;
+    idx->count = 0;
+    idx->broken = 0;
+}
+
+void id_index_free(IdIndex *idx)
+{
+    free(idx->slots);
+    id_index_init(idx);
+}
+
+// Place an entry without checking load factor (slot array must have room)
+static void place(IdSlot *slots, size_t capacity, emp *node, int id)
+{
+    size_t i = id_hash(id, capacity);
+    while (slots[i].node != NULL && slots[i].id != id)
+        i = (i + 1) & (capacity - 1);
+    slots[i].node = node;
+    slots[i].id = id;
+}
+
+// Grow (or first allocate) so that 'needed' entries stay under 50% load
+static int reserve(IdIndex *idx, size_t needed)
+{
+    if (needed * 2 <= idx->capacity)
+        return 0;
+
+    size_t capacity = idx->capacity ? idx->capacity : ID_INDEX_MIN_CAPACITY;
+    while (needed * 2 > capacity)
+        capacity *= 2;
+
+    IdSlot *slots = (IdSlot *)calloc(capacity, sizeof(IdSlot));
+    if (slots == NULL)
+    {
+        idx->broken = 1;
+        return -1;
+    }
+
+    for (size_t i = 0; i < idx->capacity; i++)
+    {
+        if (idx->slots[i].node != NULL)
+            place(slots, capacity, idx->slots[i].node, idx->slots[i].id);
+    }
+
+    free(idx->slots);
+    idx->slots = slots;
+    idx->capacity = capacity;
+    return 0;
+}
+
+void id_index_build(IdIndex *idx, emp *head)
+{
+    size_t rows = 0;
+    for (emp *curr = head; curr != NULL; curr = curr->next)
+        rows++;
+
+    if (reserve(idx, idx->count + rows) != 0)
+        return;
+
+    for (emp *curr = head; curr != NULL; curr = curr->next)
+    {
+        if (id_index_find(idx, curr->id) == NULL)
+        {
+            place(idx->slots, idx->capacity, curr, curr->id);
+            idx->count++;
+        }
+    }
+}
+
+emp *id_index_find(const IdIndex *idx, int id)
+{
+    if (idx->capacity == 0)
+        return NULL;
+
+    size_t i = id_hash(id, idx->capacity);
+    while (idx->slots[i].node != NULL)
+    {
+        if (idx->slots[i].id == id)
+            return idx->slots[i].node;
+        i = (i + 1) & (idx->capacity - 1);
+    }
+    return NULL;
+}
+
+void id_index_put(IdIndex *idx, emp *node)
+{
+    if (reserve(idx, idx->count + 1) != 0)
+        return;
+
+    size_t i = id_hash(node->id, idx->capacity);
+    while (idx->slots[i].node != NULL && idx->slots[i].id != node->id)
+        i = (i + 1) & (idx->capacity - 1);
+
+    if (idx->slots[i].node == NULL)
+        idx->count++;
+    idx->slots[i].node = node;
+    idx->slots[i].id = node->id;
+}
+
+void id_index_remove(IdIndex *idx, int id)
+{
+    if (idx->capacity == 0)
+        return;
+
+    size_t mask = idx->capacity - 1;
+    size_t i = id_hash(id, idx->capacity);
+    while (idx->slots[i].node != NULL && idx->slots[i].id != id)
+        i = (i + 1) & mask;
+
+    if (idx->slots[i].node == NULL)
+        return;
+
+    // Backward-shift deletion: pull later entries of the probe run into the hole
+    size_t hole = i;
+    size_t j = i;
+    for (;;)
+    {
+        j = (j + 1) & mask;
+        if (idx->slots[j].node == NULL)
+            break;
+
+        size_t home = id_hash(idx->slots[j].id, idx->capacity);
+        // Move j into the hole only if its home is not in (hole, j]
+        if (((j - home) & mask) >= ((j - hole) & mask))
+        {
+            idx->slots[hole] = idx->slots[j];
+            hole = j;
+        }
+    }
+    idx->slots[hole].node = NULL;
+    idx->count--;
+}
@@ -7,8 +7,14 @@
 // Helper: Get current Timestamp
 void get_time_string(char *buffer, size_t size) {
     time_t now = time(NULL);
-    struct tm *t = localtime(&now);
-    strftime(buffer, size, "%Y-%m-%d %H:%M:%S", t);
+    struct tm t;
+    // localtime() shares one buffer between threads
+    #ifdef _WIN32
+        localtime_s(&t, &now);
+    #else
+        localtime_r(&now, &t);
+    #endif
+    strftime(buffer, size, "%Y-%m-%d %H:%M:%S", &t);
 }
 
 // 1. WRITE LOG (The "Add" Function)
@@ -1,10 +1,15 @@
 // File_Name main.c
 // Entry Point for the LinkedVault Backend Server
 
+#include <signal.h>
+
 #include "handlers.h"
 #include "employee.h"
 #include "utils.h"
 #include "storage.h"
+#include "config.h"
+#include "checkpointer.h"
+#include "workers.h"
 
 // --- CONSTANTS ---
 // Listening on 0.0.0.0 allows access from external IPs, not just localhost.
@@ -16,6 +21,102 @@ static const int POLL_INTERVAL_MS = 1000;
 // Protects users.bin and tables_registry.bin operations
 pthread_mutex_t file_registry_lock = PTHREAD_MUTEX_INITIALIZER;
 
+// Set by SIGINT/SIGTERM so the main loop can flush and exit cleanly
+static volatile sig_atomic_t s_signo = 0;
+static void signal_handler(int signo)
+{
+  s_signo = signo;
+}
+
+//  --- ROUTING LOGIC ---
+// Runs on a worker thread (or inline when EMS_WORKERS=0). 'c' may be the
+// worker's capture connection, so handlers only write replies into it.
+static void route_request(struct mg_connection *c, struct mg_http_message *hm)
+{
+  if (mg_match(hm->uri, mg_str("/auth/get_user"), NULL) && is_method(hm, "POST"))
+  {
+    handle_get_user(c, hm);
+  }
+  else if (mg_match(hm->uri, mg_str("/auth/register"), NULL) && is_method(hm, "POST"))
+  {
+    handle_registry(c, hm);
+  }
+  else if (mg_match(hm->uri, mg_str("/meta/create_table"), NULL) && is_method(hm, "POST"))
+  {
+    handle_create_table(c, hm);
+  }
+  else if (mg_match(hm->uri, mg_str("/meta/list_tables"), NULL) && is_method(hm, "POST"))
+  {
+    handle_list_table(c, hm);
+  }
+  else if (mg_match(hm->uri, mg_str("/history"), NULL) && is_method(hm, "GET"))
+  {
+    handle_history(c, hm);
+  }
+  else if (mg_match(hm->uri, mg_str("/insert"), NULL) && is_method(hm, "POST"))
+  {
+    handle_insertion(c, hm);
+  }
+  else if (mg_match(hm->uri, mg_str("/show"), NULL) && is_method(hm, "GET"))
+  {
+    handle_showall(c, hm);
+  }
+  else if (mg_match(hm->uri, mg_str("/search"), NULL) && is_method(hm, "GET"))
+  {
+    handle_search(c, hm);
+  }
+  else if (mg_match(hm->uri, mg_str("/range"), NULL) && is_method(hm, "GET"))
+  {
+    handle_range(c, hm);
+  }
+  else if (mg_match(hm->uri, mg_str("/changes"), NULL) && is_method(hm, "GET"))
+  {
+    handle_changes(c, hm);
+  }
+  else if (mg_match(hm->uri, mg_str("/aggregates"), NULL) && is_method(hm, "GET"))
+  {
+    handle_aggregates(c, hm);
+  }
+  else if (mg_match(hm->uri, mg_str("/delete"), NULL) && is_method(hm, "DELETE"))
+  {
+    handle_delete(c, hm);
+  }
+  else if (mg_match(hm->uri, mg_str("/linkedreverse"), NULL) && is_method(hm, "PUT"))
+  {
+    handle_reverse(c, hm);
+  }
+  else if (mg_match(hm->uri, mg_str("/recursivereverse"), NULL) && is_method(hm, "GET"))
+  {
+    handle_recursive_reverse(c, hm);
+  }
+  else if (mg_match(hm->uri, mg_str("/update"), NULL) && is_method(hm, "PUT"))
+  {
+    handle_update(c, hm);
+  }
+  else if (mg_match(hm->uri, mg_str("/batch"), NULL) && is_method(hm, "POST"))
+  {
+    handle_batch(c, hm);
+  }
+  else if (mg_match(hm->uri, mg_str("/upload_csv"), NULL) && is_method(hm, "POST"))
+  {
+    handle_import(c, hm);
+  }
+  else if (mg_match(hm->uri, mg_str("/download_table"), NULL) && is_method(hm, "GET"))
+  {
+    handle_export(c, hm);
+  }
+  else if (mg_match(hm->uri, mg_str("/delete_table"), NULL) && is_method(hm, "DELETE"))
+  {
+    handle_clear_table(c, hm);
+  }
+  // Default Catch-All: 404 Not Found
+  else
+  {
+    mg_http_reply(c, 404, "Access-Control-Allow-Origin: *\r\n",
+                "Endpoint not found\n");
+  }
+}
+
 // ---  EVENT HANDLER ---
 static void fn(struct mg_connection *c, int ev, void *ev_data)
 {
@@ -37,93 +138,48 @@ static void fn(struct mg_connection *c, int ev, void *ev_data)
       return;
     }
 
-    //  --- ROUTING LOGIC ---
-    if (mg_match(hm->uri, mg_str("/auth/get_user"), NULL) && is_method(hm, "POST"))
-    {
-      handle_get_user(c, hm);
-    }
-    else if (mg_match(hm->uri, mg_str("/auth/register"), NULL) && is_method(hm, "POST"))
-    {
-      handle_registry(c, hm);
-    }
-    else if (mg_match(hm->uri, mg_str("/meta/create_table"), NULL) && is_method(hm, "POST"))
-    {
-      handle_create_table(c, hm);
-    }
-    else if (mg_match(hm->uri, mg_str("/meta/list_tables"), NULL) && is_method(hm, "POST"))
-    {
-      handle_list_table(c, hm);
-    }
-    else if (mg_match(hm->uri, mg_str("/history"), NULL) && is_method(hm, "GET"))
-    {
-      handle_history(c, hm);
-    }
-    else if (mg_match(hm->uri, mg_str("/insert"), NULL) && is_method(hm, "POST"))
-    {
-      handle_insertion(c, hm);
-    }
-    else if (mg_match(hm->uri, mg_str("/show"), NULL) && is_method(hm, "GET"))
-    {
-      handle_showall(c, hm);
-    }
-    else if (mg_match(hm->uri, mg_str("/search"), NULL) && is_method(hm, "GET"))
+    // Everything else goes to the pool; the reply comes back via MG_EV_WAKEUP
+    if (workers_submit(c, hm) != 0)
     {
-      handle_search(c, hm);
-    }
-    else if (mg_match(hm->uri, mg_str("/delete"), NULL) && is_method(hm, "DELETE"))
-    {
-      handle_delete(c, hm);
-    }
-    else if (mg_match(hm->uri, mg_str("/linkedreverse"), NULL) && is_method(hm, "PUT"))
-    {
-      handle_reverse(c, hm);
-    }
-    else if (mg_match(hm->uri, mg_str("/recursivereverse"), NULL) && is_method(hm, "GET"))
-    {
-      handle_recursive_reverse(c, hm);
-    }
-    else if (mg_match(hm->uri, mg_str("/update"), NULL) && is_method(hm, "PUT"))
-    {
-      handle_update(c, hm);
-    }
-    else if (mg_match(hm->uri, mg_str("/upload_csv"), NULL) && is_method(hm, "POST"))
-    {
-      handle_import(c, hm);
-    }
-    else if (mg_match(hm->uri, mg_str("/download_table"), NULL) && is_method(hm, "GET"))
-    {
-      handle_export(c, hm);
-    }
-    else if (mg_match(hm->uri, mg_str("/delete_table"), NULL) && is_method(hm, "DELETE"))
-    {
-      handle_clear_table(c, hm);
-    }
-    // Default Catch-All: 404 Not Found
-    else
-    {
-      mg_http_reply(c, 404, "Access-Control-Allow-Origin: *\r\n",
-                  "Endpoint not found\n");
+      route_request(c, hm);
+      // Streamed replies are written with mg_printf, which leaves is_resp set
+      c->is_resp = 0;
     }
   }
+  else if (ev == MG_EV_WAKEUP || ev == MG_EV_POLL || ev == MG_EV_CLOSE)
+  {
+    workers_event(c, ev);
+  }
 }
 
 int main(void)
 {
   struct mg_mgr mgr;
+
+  load_server_config();
+  signal(SIGINT, signal_handler);
+  signal(SIGTERM, signal_handler);
+
   mg_mgr_init(&mgr);
 
   // Setup the HTTP listener.
   mg_http_listen(&mgr, LISTENING_ADDR, fn, NULL);
+  start_workers(&mgr, server_config.workers, route_request);
+  start_checkpointer();
   printf("Server running on port 8000...\n");
 
   // --- Main Loop ---
-  // This Infinite loop keep the server running
-  for (;;)
+  // Keeps the server running until we are asked to stop
+  while (s_signo == 0)
   {
     mg_mgr_poll(&mgr, POLL_INTERVAL_MS);
   }
 
-  // Cleanup
+  // Cleanup: flush every dirty table before exiting
+  printf("Shutting down (signal %d), flushing tables...\n", (int)s_signo);
+  stop_workers();
+  mg_mgr_poll(&mgr, 0); // Hand over replies finished while the queue drained
+  stop_checkpointer();
   mg_mgr_free(&mgr);
   return 0;
 }
\ No newline at end of file
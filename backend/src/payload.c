@@ -0,0 +1,434 @@
+// File_Name payload.c
+// Non-allocating parser for insert / update request bodies
+
+#include <ctype.h>
+#include <limits.h>
+
+#include "payload.h"
+
+#define PAYLOAD_MAX_DEPTH 16    // Deeper unknown values are left to cJSON
+
+typedef struct {
+    const char *p;
+    const char *end;
+} Reader;
+
+// Which struct member a key maps to
+typedef enum {
+    KEY_UNKNOWN,
+    KEY_TABLE_ID,
+    KEY_OWNER_ID,
+    KEY_POSITION,
+    KEY_ORIGINAL_ID,
+    KEY_DATA,
+    KEY_ID,
+    KEY_NAME,
+    KEY_AGE,
+    KEY_DEPARTMENT,
+    KEY_SALARY
+} PayloadKey;
+
+// Same as cJSON: everything up to and including ' ' is whitespace
+static void skip_ws(Reader *r)
+{
+    while (r->p < r->end && (unsigned char)*r->p <= 32)
+        r->p++;
+}
+
+// Helper: case-insensitive compare of a raw key against a literal
+static bool key_is(const char *key, size_t len, const char *name)
+{
+    size_t i = 0;
+    for (; i < len && name[i] != '\0'; i++)
+    {
+        if (tolower((unsigned char)key[i]) != name[i])
+            return false;
+    }
+    return i == len && name[i] == '\0';
+}
+
+static PayloadKey lookup_key(const char *key, size_t len, bool in_data)
+{
+    if (in_data)
+    {
+        if (key_is(key, len, "id")) return KEY_ID;
+        if (key_is(key, len, "name")) return KEY_NAME;
+        if (key_is(key, len, "age")) return KEY_AGE;
+        if (key_is(key, len, "department")) return KEY_DEPARTMENT;
+        if (key_is(key, len, "salary")) return KEY_SALARY;
+        return KEY_UNKNOWN;
+    }
+    if (key_is(key, len, "table_id")) return KEY_TABLE_ID;
+    if (key_is(key, len, "owner_id")) return KEY_OWNER_ID;
+    if (key_is(key, len, "position")) return KEY_POSITION;
+    if (key_is(key, len, "original_id")) return KEY_ORIGINAL_ID;
+    if (key_is(key, len, "data")) return KEY_DATA;
+    return KEY_UNKNOWN;
+}
+
+// Plain string (no escapes, no control characters): returns its raw bytes
+static int read_string(Reader *r, const char **start, size_t *len)
+{
+    r->p++; // Opening quote
+    *start = r->p;
+    while (r->p < r->end && *r->p != '"')
+    {
+        unsigned char ch = (unsigned char)*r->p;
+        if (ch == '\\' || ch < 0x20)
+            return -1;
+        r->p++;
+    }
+    if (r->p == r->end)
+        return -1;
+
+    *len = (size_t)(r->p - *start);
+    r->p++; // Closing quote
+    return 0;
+}
+
+// Plain integer, clamped to int the way cJSON fills valueint
+static int read_int(Reader *r, int *value)
+{
+    bool negative = false;
+    if (*r->p == '-')
+    {
+        negative = true;
+        r->p++;
+    }
+
+    const char *digits = r->p;
+    long long magnitude = 0;
+    while (r->p < r->end && *r->p >= '0' && *r->p <= '9')
+    {
+        if (r->p - digits >= 18)
+            return -1;
+        magnitude = magnitude * 10 + (*r->p - '0');
+        r->p++;
+    }
+
+    size_t count = (size_t)(r->p - digits);
+    if (count == 0 || (count > 1 && digits[0] == '0'))
+        return -1;
+    if (r->p < r->end && (*r->p == '.' || *r->p == 'e' || *r->p == 'E' || *r->p == '+' || *r->p == '-'))
+        return -1;
+
+    long long number = negative ? -magnitude : magnitude;
+    *value = number >= INT_MAX ? INT_MAX : number <= INT_MIN ? INT_MIN : (int)number;
+    return 0;
+}
+
+static int read_literal(Reader *r, const char *word)
+{
+    size_t len = strlen(word);
+    if ((size_t)(r->end - r->p) < len || memcmp(r->p, word, len) != 0)
+        return -1;
+    r->p += len;
+    return 0;
+}
+
+static int skip_value(Reader *r, int depth);
+
+// Helper: walk an object or array whose members we don't care about
+static int skip_container(Reader *r, int depth)
+{
+    char close = *r->p == '{' ? '}' : ']';
+    bool is_object = close == '}';
+    r->p++;
+
+    skip_ws(r);
+    if (r->p < r->end && *r->p == close)
+    {
+        r->p++;
+        return 0;
+    }
+
+    while (r->p < r->end)
+    {
+        if (is_object)
+        {
+            const char *key;
+            size_t key_len;
+            if (*r->p != '"' || read_string(r, &key, &key_len) != 0)
+                return -1;
+            skip_ws(r);
+            if (r->p == r->end || *r->p != ':')
+                return -1;
+            r->p++;
+            skip_ws(r);
+        }
+
+        if (skip_value(r, depth + 1) != 0)
+            return -1;
+
+        skip_ws(r);
+        if (r->p == r->end)
+            return -1;
+        if (*r->p == close)
+        {
+            r->p++;
+            return 0;
+        }
+        if (*r->p != ',')
+            return -1;
+        r->p++;
+        skip_ws(r);
+    }
+    return -1;
+}
+
+static int skip_value(Reader *r, int depth)
+{
+    if (r->p == r->end || depth > PAYLOAD_MAX_DEPTH)
+        return -1;
+
+    const char *start;
+    size_t len;
+    int number;
+    switch (*r->p)
+    {
+    case '"': return read_string(r, &start, &len);
+    case '{':
+    case '[': return skip_container(r, depth);
+    case 't': return read_literal(r, "true");
+    case 'f': return read_literal(r, "false");
+    case 'n': return read_literal(r, "null");
+    default: return read_int(r, &number);
+    }
+}
+
+// Helper: a value for one of the known keys
+static int read_field(Reader *r, PayloadField *field)
+{
+    if (*r->p == '-' || (*r->p >= '0' && *r->p <= '9'))
+    {
+        field->kind = FIELD_NUMBER;
+        return read_int(r, &field->value);
+    }
+
+    field->kind = *r->p == '"' ? FIELD_STRING : *r->p == '{' ? FIELD_OBJECT : FIELD_OTHER;
+    field->value = *r->p == 't' ? 1 : 0; // cJSON sets valueint = 1 for true
+    return skip_value(r, 1);
+}
+
+// Helper: name / department straight into the record
+static int read_text(Reader *r, FieldKind *kind, char *dest, size_t *full_len, bool *alpha)
+{
+    if (*r->p != '"')
+    {
+        PayloadField other;
+        if (read_field(r, &other) != 0)
+            return -1;
+        *kind = other.kind;
+        return 0;
+    }
+
+    const char *start;
+    size_t len;
+    if (read_string(r, &start, &len) != 0)
+        return -1;
+
+    *kind = FIELD_STRING;
+    *full_len = len;
+    *alpha = true;
+    for (size_t i = 0; i < len; i++)
+    {
+        if (!isalpha((unsigned char)start[i]) && start[i] != ' ')
+        {
+            *alpha = false;
+            break;
+        }
+    }
+
+    size_t keep = len < 49 ? len : 49;
+    memcpy(dest, start, keep);
+    dest[keep] = '\0';
+    return 0;
+}
+
+static int read_object(Reader *r, EmployeePayload *out, bool in_data);
+
+// Helper: one "key": value member
+static int read_member(Reader *r, EmployeePayload *out, bool in_data)
+{
+    const char *key;
+    size_t key_len;
+    if (*r->p != '"' || read_string(r, &key, &key_len) != 0)
+        return -1;
+
+    skip_ws(r);
+    if (r->p == r->end || *r->p != ':')
+        return -1;
+    r->p++;
+    skip_ws(r);
+    if (r->p == r->end)
+        return -1;
+
+    PayloadKey which = lookup_key(key, key_len, in_data);
+    PayloadField *field = NULL;
+    switch (which)
+    {
+    case KEY_TABLE_ID: field = &out->table_id; break;
+    case KEY_OWNER_ID: field = &out->owner_id; break;
+    case KEY_POSITION: field = &out->position; break;
+    case KEY_ORIGINAL_ID: field = &out->original_id; break;
+    case KEY_ID: field = &out->id; break;
+    case KEY_AGE: field = &out->age; break;
+    case KEY_SALARY: field = &out->salary; break;
+
+    case KEY_DATA:
+        if (out->data != FIELD_MISSING)
+            return skip_value(r, 1);
+        if (*r->p == '{')
+        {
+            out->data = FIELD_OBJECT;
+            return read_object(r, out, true);
+        }
+        else
+        {
+            PayloadField other;
+            int rc = read_field(r, &other);
+            out->data = other.kind;
+            return rc;
+        }
+
+    case KEY_NAME:
+        if (out->name != FIELD_MISSING)
+            return skip_value(r, 1);
+        return read_text(r, &out->name, out->record.name, &out->name_len, &out->name_alpha);
+
+    case KEY_DEPARTMENT:
+        if (out->department != FIELD_MISSING)
+            return skip_value(r, 1);
+        return read_text(r, &out->department, out->record.department, &out->dept_len, &out->dept_alpha);
+
+    case KEY_UNKNOWN:
+        return skip_value(r, 1);
+    }
+
+    // First occurrence wins
+    if (field->kind != FIELD_MISSING)
+        return skip_value(r, 1);
+    return read_field(r, field);
+}
+
+static int read_object(Reader *r, EmployeePayload *out, bool in_data)
+{
+    r->p++; // '{'
+    skip_ws(r);
+    if (r->p < r->end && *r->p == '}')
+    {
+        r->p++;
+        return 0;
+    }
+
+    while (r->p < r->end)
+    {
+        if (read_member(r, out, in_data) != 0)
+            return -1;
+
+        skip_ws(r);
+        if (r->p == r->end)
+            return -1;
+        if (*r->p == '}')
+        {
+            r->p++;
+            return 0;
+        }
+        if (*r->p != ',')
+            return -1;
+        r->p++;
+        skip_ws(r);
+    }
+    return -1;
+}
+
+// --- FALLBACK: let cJSON parse it, then copy out the same fields ---
+static FieldKind kind_of(const cJSON *item)
+{
+    if (item == NULL) return FIELD_MISSING;
+    if (cJSON_IsNumber(item)) return FIELD_NUMBER;
+    if (cJSON_IsString(item)) return FIELD_STRING;
+    if (cJSON_IsObject(item)) return FIELD_OBJECT;
+    return FIELD_OTHER;
+}
+
+static void copy_field(const cJSON *item, PayloadField *field)
+{
+    field->kind = kind_of(item);
+    field->value = item ? item->valueint : 0;
+}
+
+static void copy_text(const cJSON *item, FieldKind *kind, char *dest, size_t *full_len, bool *alpha)
+{
+    *kind = kind_of(item);
+    if (*kind != FIELD_STRING || item->valuestring == NULL)
+        return;
+
+    const char *str = item->valuestring;
+    *full_len = strlen(str);
+    *alpha = true;
+    for (size_t i = 0; str[i] != '\0'; i++)
+    {
+        if (!isalpha((unsigned char)str[i]) && str[i] != ' ')
+        {
+            *alpha = false;
+            break;
+        }
+    }
+    strncpy(dest, str, 49);
+    dest[49] = '\0';
+}
+
+void payload_from_json(const cJSON *json, EmployeePayload *out)
+{
+    memset(out, 0, sizeof(*out));
+    copy_field(cJSON_GetObjectItem(json, "table_id"), &out->table_id);
+    copy_field(cJSON_GetObjectItem(json, "owner_id"), &out->owner_id);
+    copy_field(cJSON_GetObjectItem(json, "position"), &out->position);
+    copy_field(cJSON_GetObjectItem(json, "original_id"), &out->original_id);
+
+    cJSON *data = cJSON_GetObjectItem(json, "data");
+    out->data = kind_of(data);
+    if (data)
+    {
+        copy_field(cJSON_GetObjectItem(data, "id"), &out->id);
+        copy_field(cJSON_GetObjectItem(data, "age"), &out->age);
+        copy_field(cJSON_GetObjectItem(data, "salary"), &out->salary);
+        copy_text(cJSON_GetObjectItem(data, "name"), &out->name, out->record.name, &out->name_len, &out->name_alpha);
+        copy_text(cJSON_GetObjectItem(data, "department"), &out->department, out->record.department, &out->dept_len, &out->dept_alpha);
+    }
+
+    out->record.id = out->id.value;
+    out->record.age = out->age.value;
+    out->record.salary = out->salary.value;
+}
+
+static int parse_with_cjson(const char *body, size_t len, EmployeePayload *out)
+{
+    cJSON *json = cJSON_ParseWithLength(body, len);
+    if (!json)
+        return -1;
+
+    payload_from_json(json, out);
+    cJSON_Delete(json);
+    return 0;
+}
+
+int parse_employee_payload(const char *body, size_t len, EmployeePayload *out)
+{
+    memset(out, 0, sizeof(*out));
+
+    Reader r = {body, body + len};
+    skip_ws(&r);
+
+    // Fast path: one pass over the body (anything after the object is ignored, as in cJSON)
+    if (r.p < r.end && *r.p == '{' && read_object(&r, out, false) == 0)
+    {
+        out->record.id = out->id.value;
+        out->record.age = out->age.value;
+        out->record.salary = out->salary.value;
+        return 0;
+    }
+
+    return parse_with_cjson(body, len, out);
+}
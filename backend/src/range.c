@@ -0,0 +1,329 @@
+// File_Name range.c
+// Sorted secondary index on one integer column (age / salary)
+
+#include <limits.h>
+
+#include "range.h"
+
+#define RANGE_PENDING_MIN 256   // Pending run may always hold this many entries
+#define RANGE_PENDING_SHARE 32  // ...or 1/32 of the main array, whichever is larger
+
+void range_index_init(RangeIndex *ri)
+{
+    memset(ri, 0, sizeof(*ri));
+}
+
+void range_index_free(RangeIndex *ri)
+{
+    free(ri->main);
+    free(ri->pending);
+    free(ri->removed);
+    range_index_init(ri);
+}
+
+static inline int entry_less(int key_a, int id_a, int key_b, int id_b)
+{
+    return key_a < key_b || (key_a == key_b && id_a < id_b);
+}
+
+static int compare_entries(const void *a, const void *b)
+{
+    const RangeEntry *x = (const RangeEntry *)a, *y = (const RangeEntry *)b;
+    return entry_less(y->key, y->id, x->key, x->id) - entry_less(x->key, x->id, y->key, y->id);
+}
+
+// Helper: first position whose entry is not less than (key, id)
+static size_t lower_bound(const RangeEntry *arr, size_t len, int key, int id)
+{
+    size_t lo = 0, hi = len;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (entry_less(arr[mid].key, arr[mid].id, key, id))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+static int reserve(RangeEntry **arr, size_t *capacity, size_t needed)
+{
+    if (needed <= *capacity)
+        return 0;
+
+    size_t grown_capacity = *capacity ? *capacity : 64;
+    while (grown_capacity < needed)
+        grown_capacity *= 2;
+
+    RangeEntry *grown = (RangeEntry *)realloc(*arr, grown_capacity * sizeof(RangeEntry));
+    if (grown == NULL)
+        return -1;
+    *arr = grown;
+    *capacity = grown_capacity;
+    return 0;
+}
+
+int range_index_build(RangeIndex *ri, const RangeEntry *entries, size_t count)
+{
+    range_index_free(ri);
+
+    if (reserve(&ri->main, &ri->main_capacity, count ? count : 1) != 0)
+        return -1;
+
+    if (count)
+        memcpy(ri->main, entries, count * sizeof(RangeEntry));
+    qsort(ri->main, count, sizeof(RangeEntry), compare_entries);
+    ri->main_len = count;
+    ri->built = 1;
+    return 0;
+}
+
+static inline int entry_is(const RangeEntry *e, int key, int id)
+{
+    return e->key == key && e->id == id;
+}
+
+// Helper: has a side run (pending / removed) grown enough to fold into 'main'?
+static inline int run_full(const RangeIndex *ri, size_t len)
+{
+    return len >= RANGE_PENDING_MIN && len >= ri->main_len / RANGE_PENDING_SHARE;
+}
+
+// Helper: drop the entries listed in 'removed' from the main array (one pass,
+// both are sorted)
+static void apply_removed(RangeIndex *ri)
+{
+    if (ri->removed_len == 0)
+        return;
+
+    size_t out = 0, j = 0;
+    for (size_t i = 0; i < ri->main_len; i++)
+    {
+        const RangeEntry *e = &ri->main[i];
+        if (j < ri->removed_len && entry_is(&ri->removed[j], e->key, e->id))
+        {
+            j++;
+            continue;
+        }
+        ri->main[out++] = *e;
+    }
+    ri->main_len = out;
+    ri->removed_len = 0;
+}
+
+// Helper: fold the pending run into the main array (merging from the back)
+static int merge_pending(RangeIndex *ri)
+{
+    // A re-added entry may still sit in 'main' as removed: drop those first
+    apply_removed(ri);
+
+    if (reserve(&ri->main, &ri->main_capacity, ri->main_len + ri->pending_len) != 0)
+        return -1;
+
+    size_t i = ri->main_len, j = ri->pending_len, out = ri->main_len + ri->pending_len;
+    while (j > 0)
+    {
+        if (i > 0 && entry_less(ri->pending[j - 1].key, ri->pending[j - 1].id, ri->main[i - 1].key, ri->main[i - 1].id))
+            ri->main[--out] = ri->main[--i];
+        else
+            ri->main[--out] = ri->pending[--j];
+    }
+
+    ri->main_len += ri->pending_len;
+    ri->pending_len = 0;
+    return 0;
+}
+
+void range_index_add(RangeIndex *ri, int key, int id)
+{
+    if (!ri->built)
+        return;
+
+    if (reserve(&ri->pending, &ri->pending_capacity, ri->pending_len + 1) != 0)
+    {
+        range_index_free(ri);
+        return;
+    }
+
+    size_t pos = lower_bound(ri->pending, ri->pending_len, key, id);
+    memmove(&ri->pending[pos + 1], &ri->pending[pos], (ri->pending_len - pos) * sizeof(RangeEntry));
+    ri->pending[pos].key = key;
+    ri->pending[pos].id = id;
+    ri->pending_len++;
+
+    if (run_full(ri, ri->pending_len) && merge_pending(ri) != 0)
+    {
+        range_index_free(ri);
+    }
+}
+
+void range_index_remove(RangeIndex *ri, int key, int id)
+{
+    if (!ri->built)
+        return;
+
+    // The pending run is small: take the entry straight out of it
+    size_t pos = lower_bound(ri->pending, ri->pending_len, key, id);
+    if (pos < ri->pending_len && entry_is(&ri->pending[pos], key, id))
+    {
+        memmove(&ri->pending[pos], &ri->pending[pos + 1], (ri->pending_len - pos - 1) * sizeof(RangeEntry));
+        ri->pending_len--;
+        return;
+    }
+
+    // The main array is not: only list the entry as removed (once)
+    pos = lower_bound(ri->main, ri->main_len, key, id);
+    if (pos == ri->main_len || !entry_is(&ri->main[pos], key, id))
+        return;
+
+    pos = lower_bound(ri->removed, ri->removed_len, key, id);
+    if (pos < ri->removed_len && entry_is(&ri->removed[pos], key, id))
+        return;
+
+    if (reserve(&ri->removed, &ri->removed_capacity, ri->removed_len + 1) != 0)
+    {
+        range_index_free(ri);
+        return;
+    }
+
+    memmove(&ri->removed[pos + 1], &ri->removed[pos], (ri->removed_len - pos) * sizeof(RangeEntry));
+    ri->removed[pos].key = key;
+    ri->removed[pos].id = id;
+    ri->removed_len++;
+
+    if (run_full(ri, ri->removed_len))
+        apply_removed(ri);
+}
+
+// Helpers: smallest / largest entry of the main array not listed as removed.
+// 'removed' is a sorted subset of 'main', so removed entries at either end of
+// 'main' line up with the same end of 'removed'.
+static const RangeEntry *main_first(const RangeIndex *ri)
+{
+    size_t i = 0, j = 0;
+    while (i < ri->main_len && j < ri->removed_len && entry_is(&ri->removed[j], ri->main[i].key, ri->main[i].id))
+    {
+        i++;
+        j++;
+    }
+    return i < ri->main_len ? &ri->main[i] : NULL;
+}
+
+static const RangeEntry *main_last(const RangeIndex *ri)
+{
+    size_t i = ri->main_len, j = ri->removed_len;
+    while (i > 0 && j > 0 && entry_is(&ri->removed[j - 1], ri->main[i - 1].key, ri->main[i - 1].id))
+    {
+        i--;
+        j--;
+    }
+    return i > 0 ? &ri->main[i - 1] : NULL;
+}
+
+int range_index_bounds(const RangeIndex *ri, int *min, int *max)
+{
+    const RangeEntry *first = main_first(ri), *last = main_last(ri);
+    size_t m = ri->pending_len;
+    if (first == NULL && m == 0)
+        return 0;
+
+    // Both runs are sorted: the ends of each are the candidates
+    if (first == NULL)
+    {
+        *min = ri->pending[0].key;
+        *max = ri->pending[m - 1].key;
+    }
+    else if (m == 0)
+    {
+        *min = first->key;
+        *max = last->key;
+    }
+    else
+    {
+        *min = first->key < ri->pending[0].key ? first->key : ri->pending[0].key;
+        *max = last->key > ri->pending[m - 1].key ? last->key : ri->pending[m - 1].key;
+    }
+    return 1;
+}
+
+// Helper: entries of one sorted run inside [min, max]
+static size_t count_in(const RangeEntry *arr, size_t len, int min, int max)
+{
+    size_t first = lower_bound(arr, len, min, INT_MIN);
+    size_t last = max == INT_MAX ? len : lower_bound(arr, len, max + 1, INT_MIN);
+    return last > first ? last - first : 0;
+}
+
+size_t range_index_count(const RangeIndex *ri, int min, int max)
+{
+    if (min > max)
+        return 0;
+    return count_in(ri->main, ri->main_len, min, max) - count_in(ri->removed, ri->removed_len, min, max) +
+           count_in(ri->pending, ri->pending_len, min, max);
+}
+
+void range_index_seek(const RangeIndex *ri, int min, int max, RangeCursor *cur)
+{
+    cur->index = ri;
+    cur->max = max;
+    // Smallest possible id, so every entry with key == min is included
+    cur->main_pos = lower_bound(ri->main, ri->main_len, min, INT_MIN);
+    cur->pending_pos = lower_bound(ri->pending, ri->pending_len, min, INT_MIN);
+    cur->removed_pos = lower_bound(ri->removed, ri->removed_len, min, INT_MIN);
+}
+
+// Helper: step the main position past entries listed as removed
+static void skip_removed(RangeCursor *cur)
+{
+    const RangeIndex *ri = cur->index;
+    while (cur->main_pos < ri->main_len && cur->removed_pos < ri->removed_len)
+    {
+        const RangeEntry *m = &ri->main[cur->main_pos], *r = &ri->removed[cur->removed_pos];
+        if (entry_less(r->key, r->id, m->key, m->id))
+            cur->removed_pos++;
+        else if (entry_is(r, m->key, m->id))
+        {
+            cur->main_pos++;
+            cur->removed_pos++;
+        }
+        else
+            break;
+    }
+}
+
+int range_cursor_next(RangeCursor *cur, int *id)
+{
+    const RangeIndex *ri = cur->index;
+    skip_removed(cur);
+    const RangeEntry *m = cur->main_pos < ri->main_len ? &ri->main[cur->main_pos] : NULL;
+    const RangeEntry *p = cur->pending_pos < ri->pending_len ? &ri->pending[cur->pending_pos] : NULL;
+
+    // Take the smaller head of the two runs
+    const RangeEntry *next;
+    if (m != NULL && (p == NULL || entry_less(m->key, m->id, p->key, p->id)))
+    {
+        next = m;
+        cur->main_pos++;
+    }
+    else if (p != NULL)
+    {
+        next = p;
+        cur->pending_pos++;
+    }
+    else
+    {
+        return 0;
+    }
+
+    if (next->key > cur->max)
+    {
+        // Sorted: nothing after this is in range either
+        cur->main_pos = ri->main_len;
+        cur->pending_pos = ri->pending_len;
+        return 0;
+    }
+
+    *id = next->id;
+    return 1;
+}
@@ -0,0 +1,222 @@
+// File_Name search.c
+// Vectorized case-insensitive substring matching for handle_search
+
+#include <ctype.h>
+#include <stdint.h>
+
+#include "search.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SEARCH_X86 1
+#include <immintrin.h>
+#endif
+
+static const unsigned long long POW10[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+    10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL};
+
+// ASCII-only lowering, same as tolower() in the C locale
+static inline unsigned char fold(unsigned char ch)
+{
+    return (ch >= 'A' && ch <= 'Z') ? (unsigned char)(ch | 0x20) : ch;
+}
+
+void needle_prepare(SearchNeedle *n, const char *query)
+{
+    memset(n, 0, sizeof(*n));
+
+    size_t len = strnlen(query, NEEDLE_MAX - 1);
+    for (size_t i = 0; i < len; i++)
+        n->lower[i] = (char)fold((unsigned char)query[i]);
+    n->len = len;
+
+    // Classify against what "%d" can print: an optional '-' and digits
+    size_t start = (len > 0 && query[0] == '-') ? 1 : 0;
+    n->numeric = start ? NUMERIC_NEG_PREFIX : NUMERIC_DIGITS;
+    for (size_t i = start; i < len; i++)
+    {
+        if (query[i] < '0' || query[i] > '9')
+        {
+            n->numeric = NUMERIC_NONE;
+            return;
+        }
+    }
+
+    n->digit_count = (int)(len - start);
+    if (len == 0 || n->digit_count > 10)
+    {
+        // Longer than any int
+        n->numeric = NUMERIC_NONE;
+        return;
+    }
+    for (size_t i = start; i < len; i++)
+        n->digit_value = n->digit_value * 10 + (unsigned long long)(query[i] - '0');
+    n->leading_zero = n->digit_count > 0 && query[start] == '0';
+}
+
+// Compare hay[0..len) against needle[0..len), folding the haystack only
+static inline int equal_folded(const char *hay, const char *needle, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        if (fold((unsigned char)hay[i]) != (unsigned char)needle[i])
+            return 0;
+    }
+    return 1;
+}
+
+// Plain scan over candidate start positions [from, last]
+static int scan_scalar(const SearchNeedle *n, const char *hay, size_t from, size_t last)
+{
+    unsigned char first = (unsigned char)n->lower[0];
+    for (size_t i = from; i <= last; i++)
+    {
+        if (fold((unsigned char)hay[i]) == first && equal_folded(hay + i + 1, n->lower + 1, n->len - 1))
+            return 1;
+    }
+    return 0;
+}
+
+#ifdef SEARCH_X86
+/*
+ * SIMD filter: for 16 (or 32) start positions at once, compare the folded
+ * first and last haystack bytes of each candidate window with the needle's
+ * first and last bytes. Only positions where both match are verified.
+ * Loads never read past hay[hay_len - 1].
+ */
+static inline __m128i fold_sse2(__m128i x)
+{
+    // 'A'..'Z' shifted to the bottom of the signed range, then one compare
+    __m128i shifted = _mm_add_epi8(x, _mm_set1_epi8((char)(0x80 - 'A')));
+    __m128i upper = _mm_cmplt_epi8(shifted, _mm_set1_epi8((char)(0x80 + 26)));
+    return _mm_or_si128(x, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+static int search_sse2(const SearchNeedle *n, const char *hay, size_t hay_len)
+{
+    size_t k = n->len;
+    if (hay_len < k)
+        return 0;
+
+    size_t last = hay_len - k;
+    __m128i first = _mm_set1_epi8(n->lower[0]);
+    __m128i final = _mm_set1_epi8(n->lower[k - 1]);
+
+    size_t i = 0;
+    for (; i + k + 15 <= hay_len; i += 16)
+    {
+        __m128i block_first = fold_sse2(_mm_loadu_si128((const __m128i *)(hay + i)));
+        __m128i block_last = fold_sse2(_mm_loadu_si128((const __m128i *)(hay + i + k - 1)));
+        unsigned mask = (unsigned)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, final)));
+
+        while (mask != 0)
+        {
+            unsigned bit = (unsigned)__builtin_ctz(mask);
+            if (k <= 2 || equal_folded(hay + i + bit + 1, n->lower + 1, k - 2))
+                return 1;
+            mask &= mask - 1;
+        }
+    }
+    return i <= last ? scan_scalar(n, hay, i, last) : 0;
+}
+
+__attribute__((target("avx2"))) static inline __m256i fold_avx2(__m256i x)
+{
+    __m256i shifted = _mm256_add_epi8(x, _mm256_set1_epi8((char)(0x80 - 'A')));
+    __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 + 26)), shifted);
+    return _mm256_or_si256(x, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+
+__attribute__((target("avx2"))) static int search_avx2(const SearchNeedle *n, const char *hay, size_t hay_len)
+{
+    size_t k = n->len;
+    __m256i first = _mm256_set1_epi8(n->lower[0]);
+    __m256i final = _mm256_set1_epi8(n->lower[k - 1]);
+
+    size_t i = 0;
+    for (; i + k + 31 <= hay_len; i += 32)
+    {
+        __m256i block_first = fold_avx2(_mm256_loadu_si256((const __m256i *)(hay + i)));
+        __m256i block_last = fold_avx2(_mm256_loadu_si256((const __m256i *)(hay + i + k - 1)));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, final)));
+
+        while (mask != 0)
+        {
+            unsigned bit = (unsigned)__builtin_ctz(mask);
+            if (k <= 2 || equal_folded(hay + i + bit + 1, n->lower + 1, k - 2))
+                return 1;
+            mask &= mask - 1;
+        }
+    }
+    // Finish the (short) rest with the 16-byte kernel
+    return search_sse2(n, hay + i, hay_len - i);
+}
+
+static int have_avx2(void)
+{
+    static int cached = -1;
+    if (cached < 0)
+    {
+        __builtin_cpu_init();
+        cached = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return cached;
+}
+#endif
+
+int needle_in_text(const SearchNeedle *n, const char *hay, size_t hay_len)
+{
+    if (n->len == 0)
+        return 1;
+    if (hay_len < n->len)
+        return 0;
+
+#ifdef SEARCH_X86
+    if (hay_len >= 32 + n->len && have_avx2())
+        return search_avx2(n, hay, hay_len);
+    return search_sse2(n, hay, hay_len);
+#else
+    return scan_scalar(n, hay, 0, hay_len - n->len);
+#endif
+}
+
+int needle_in_number(const SearchNeedle *n, int value)
+{
+    if (n->numeric == NUMERIC_NONE)
+        return 0;
+
+    // Magnitude without overflowing on INT_MIN
+    unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long)(long long)value
+                                             : (unsigned long long)value;
+    int digits = 1;
+    while (digits < 10 && magnitude >= POW10[digits])
+        digits++;
+
+    if (n->numeric == NUMERIC_NEG_PREFIX)
+    {
+        // "-" followed by digits only ever appears at the very start
+        if (value >= 0)
+            return 0;
+        if (n->digit_count == 0)
+            return 1;
+        if (n->leading_zero || n->digit_count > digits)
+            return 0;
+        return magnitude / POW10[digits - n->digit_count] == n->digit_value;
+    }
+
+    // NUMERIC_DIGITS: slide an L-digit window over the digits
+    int width = n->digit_count;
+    if (width > digits)
+        return 0;
+
+    unsigned long long window = POW10[width];
+    for (int shift = 0; shift + width <= digits; shift++)
+    {
+        if (magnitude % window == n->digit_value)
+            return 1;
+        magnitude /= 10;
+    }
+    return 0;
+}
@@ -0,0 +1,327 @@
+// File_Name skiplist.c
+// Indexable skip list layered over the employee list for positional access
+
+#include "skiplist.h"
+
+void skip_init(SkipIndex *s)
+{
+    memset(s, 0, sizeof(*s));
+    s->seed = 0x9E3779B9u;
+    for (int l = 0; l < SKIP_MAX_LEVEL; l++)
+        s->head[l].width = 1; // Empty list: the tail is right after the head
+}
+
+void skip_release(SkipIndex *s, emp *node)
+{
+    struct SkipTower *tower = node->tower;
+    if (tower == NULL)
+        return;
+
+    int levels = tower->levels;
+    tower->next_free = s->towers.free[levels];
+    s->towers.free[levels] = tower;
+    node->tower = NULL;
+}
+
+void skip_free(SkipIndex *s)
+{
+    TowerChunk *chunk = s->towers.chunks;
+    while (chunk != NULL)
+    {
+        TowerChunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    skip_init(s);
+}
+
+// Helper: a zeroed tower of 'levels' levels from the arena (NULL if out of memory)
+static struct SkipTower *tower_alloc(TowerArena *a, int levels)
+{
+    struct SkipTower *tower = a->free[levels];
+
+    // 1. Reuse a released tower of the same height
+    if (tower != NULL)
+    {
+        a->free[levels] = tower->next_free;
+    }
+    // 2. Carve from the newest chunk, adding one when the tower doesn't fit
+    else
+    {
+        size_t slots = (size_t)levels + 1;
+        TowerChunk *chunk = a->chunks;
+        if (chunk == NULL || chunk->used + slots > TOWER_CHUNK_SLOTS)
+        {
+            chunk = (TowerChunk *)malloc(sizeof(TowerChunk));
+            if (chunk == NULL)
+                return NULL;
+            chunk->used = 0;
+            chunk->next = a->chunks;
+            a->chunks = chunk;
+            a->bytes += sizeof(TowerChunk);
+        }
+        tower = (struct SkipTower *)&chunk->slots[chunk->used];
+        chunk->used += slots;
+    }
+
+    memset(tower, 0, sizeof(struct SkipTower) + levels * sizeof(SkipLink));
+    return tower;
+}
+
+// Helper: levels a node takes part in, counting level 0
+static inline int height(const emp *node)
+{
+    return node->tower ? node->tower->levels + 1 : 1;
+}
+
+// Helper: express link of a node (NULL = the head) at level 'lvl' >= 1
+static inline SkipLink *link_of(SkipIndex *s, emp *node, int lvl)
+{
+    return node ? &node->tower->link[lvl - 1] : &s->head[lvl - 1];
+}
+
+// Helpers: walk any level, level 0 being the list itself
+static inline emp *next_at(const SkipIndex *s, const EmployeeList *list, const emp *node, int lvl)
+{
+    if (lvl == 0)
+        return node ? node->next : list->head;
+    return node ? node->tower->link[lvl - 1].next : s->head[lvl - 1].next;
+}
+
+static inline size_t width_at(const SkipIndex *s, const emp *node, int lvl)
+{
+    if (lvl == 0)
+        return 1;
+    return node ? node->tower->link[lvl - 1].width : s->head[lvl - 1].width;
+}
+
+static inline emp *prev_at(const emp *node, int lvl)
+{
+    return lvl == 0 ? node->prev : node->tower->link[lvl - 1].prev;
+}
+
+// Helper: allocate a tower of random height (1/4 chance per extra level).
+// Without one the node just stays on level 0, which is still correct.
+static void grow_tower(SkipIndex *s, emp *node)
+{
+    uint32_t x = s->seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s->seed = x;
+
+    int levels = 0;
+    while (levels < SKIP_MAX_LEVEL && (x & 3) == 0)
+    {
+        levels++;
+        x >>= 2;
+    }
+    if (levels == 0)
+        return;
+
+    struct SkipTower *tower = tower_alloc(&s->towers, levels);
+    if (tower == NULL)
+        return;
+    tower->levels = levels;
+    node->tower = tower;
+}
+
+void skip_relink(SkipIndex *s, EmployeeList *list)
+{
+    emp *last[SKIP_MAX_LEVEL + 1];
+    size_t last_pos[SKIP_MAX_LEVEL + 1];
+    for (int l = 1; l <= SKIP_MAX_LEVEL; l++)
+    {
+        last[l] = NULL;
+        last_pos[l] = 0;
+    }
+
+    // Positions are 1-based here so the head sits at 0
+    size_t pos = 0;
+    int top = 0;
+    for (emp *curr = list->head; curr != NULL; curr = curr->next)
+    {
+        pos++;
+        int h = height(curr);
+        for (int l = 1; l < h; l++)
+        {
+            SkipLink *from = link_of(s, last[l], l);
+            from->next = curr;
+            from->width = pos - last_pos[l];
+            curr->tower->link[l - 1].prev = last[l];
+            last[l] = curr;
+            last_pos[l] = pos;
+        }
+        if (h - 1 > top)
+            top = h - 1;
+    }
+
+    for (int l = 1; l <= SKIP_MAX_LEVEL; l++)
+    {
+        SkipLink *from = link_of(s, last[l], l);
+        from->next = NULL;
+        from->width = pos + 1 - last_pos[l];
+    }
+    s->levels = top;
+    s->count = pos;
+}
+
+void skip_build(SkipIndex *s, EmployeeList *list)
+{
+    for (emp *curr = list->head; curr != NULL; curr = curr->next)
+    {
+        if (curr->tower == NULL)
+            grow_tower(s, curr);
+    }
+    skip_relink(s, list);
+}
+
+void skip_insert(SkipIndex *s, EmployeeList *list, emp *node, size_t pos)
+{
+    if (pos > s->count)
+        pos = s->count;
+
+    if (node->tower == NULL)
+        grow_tower(s, node);
+    int h = height(node);
+
+    // New express levels start out empty: head straight to one past the tail
+    while (s->levels < h - 1)
+    {
+        s->levels++;
+        s->head[s->levels - 1].next = NULL;
+        s->head[s->levels - 1].width = s->count + 1;
+    }
+
+    // Last node before 'pos' on every level, with its 1-based position
+    emp *update[SKIP_MAX_LEVEL + 1];
+    size_t update_pos[SKIP_MAX_LEVEL + 1];
+    emp *x = NULL;
+    size_t x_pos = 0;
+    for (int l = s->levels; l >= 0; l--)
+    {
+        emp *nx;
+        while ((nx = next_at(s, list, x, l)) != NULL && x_pos + width_at(s, x, l) <= pos)
+        {
+            x_pos += width_at(s, x, l);
+            x = nx;
+        }
+        update[l] = x;
+        update_pos[l] = x_pos;
+    }
+
+    // Level 0: the list itself
+    emp *after = update[0] ? update[0]->next : list->head;
+    node->prev = update[0];
+    node->next = after;
+    if (update[0])
+        update[0]->next = node;
+    else
+        list->head = node;
+    if (after)
+        after->prev = node;
+    else
+        list->tail = node;
+
+    // Express levels the node takes part in are split around it
+    for (int l = 1; l < h; l++)
+    {
+        SkipLink *from = link_of(s, update[l], l);
+        SkipLink *mine = &node->tower->link[l - 1];
+        mine->next = from->next;
+        mine->prev = update[l];
+        mine->width = update_pos[l] + from->width - pos;
+        if (mine->next)
+            mine->next->tower->link[l - 1].prev = node;
+        from->next = node;
+        from->width = pos + 1 - update_pos[l];
+    }
+
+    // Links above it now jump one more row
+    for (int l = h; l <= s->levels; l++)
+        link_of(s, update[l], l)->width++;
+
+    s->count++;
+}
+
+void skip_remove(SkipIndex *s, EmployeeList *list, emp *node)
+{
+    int h = height(node);
+
+    // Links above the node's height that jump over it: the closest earlier
+    // node that is taller, found by climbing back along the highest links
+    int l = h;
+    emp *x = node;
+    while (l <= s->levels)
+    {
+        emp *p = prev_at(x, height(x) - 1);
+        int ph = p ? height(p) : s->levels + 1;
+        for (; l < ph; l++)
+            link_of(s, p, l)->width--;
+        x = p;
+    }
+
+    // Express levels the node takes part in are joined across it
+    for (l = 1; l < h; l++)
+    {
+        SkipLink *mine = &node->tower->link[l - 1];
+        SkipLink *from = link_of(s, mine->prev, l);
+        from->next = mine->next;
+        from->width += mine->width - 1;
+        if (mine->next)
+            mine->next->tower->link[l - 1].prev = mine->prev;
+        mine->next = NULL;
+        mine->prev = NULL;
+    }
+
+    // Level 0
+    if (node->prev == NULL)
+        list->head = node->next;
+    else
+        node->prev->next = node->next;
+    if (node->next == NULL)
+        list->tail = node->prev;
+    else
+        node->next->prev = node->prev;
+    node->next = NULL;
+    node->prev = NULL;
+
+    s->count--;
+    while (s->levels > 0 && s->head[s->levels - 1].next == NULL)
+        s->levels--;
+}
+
+emp *skip_at(const SkipIndex *s, const EmployeeList *list, size_t pos)
+{
+    if (pos >= s->count)
+        return NULL;
+
+    // Furthest node whose 1-based position is <= pos + 1
+    const emp *x = NULL;
+    size_t x_pos = 0;
+    for (int l = s->levels; l >= 0; l--)
+    {
+        emp *nx;
+        while ((nx = next_at(s, list, x, l)) != NULL && x_pos + width_at(s, x, l) <= pos + 1)
+        {
+            x_pos += width_at(s, x, l);
+            x = nx;
+        }
+    }
+    return (emp *)x;
+}
+
+size_t skip_rank(const SkipIndex *s, const emp *node)
+{
+    // Sum the widths back to the head, always leaving by the highest link
+    size_t pos = 0;
+    const emp *x = node;
+    while (x != NULL)
+    {
+        int top = height(x) - 1;
+        const emp *p = prev_at(x, top);
+        pos += width_at(s, p, top);
+        x = p;
+    }
+    return pos - 1;
+}
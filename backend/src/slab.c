@@ -0,0 +1,94 @@
+// File_Name slab.c
+// Slab allocator for employee nodes
+
+#include "slab.h"
+
+void node_alloc_init(NodeAllocator *a)
+{
+    memset(a, 0, sizeof(*a));
+}
+
+void node_alloc_destroy(NodeAllocator *a)
+{
+    Slab *slab = a->slabs;
+    while (slab != NULL)
+    {
+        Slab *next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    node_alloc_init(a);
+}
+
+static Slab *add_slab(NodeAllocator *a, size_t capacity)
+{
+    Slab *slab = (Slab *)malloc(sizeof(Slab) + capacity * sizeof(emp));
+    if (slab == NULL)
+        return NULL;
+
+    slab->capacity = capacity;
+    slab->used = 0;
+    slab->next = a->slabs;
+    a->slabs = slab;
+    a->slab_count++;
+    a->capacity += capacity;
+    return slab;
+}
+
+emp *node_alloc(NodeAllocator *a)
+{
+    emp *node = NULL;
+
+    // 1. Reuse a released node
+    if (a->free_list != NULL)
+    {
+        node = a->free_list;
+        a->free_list = node->next;
+        a->free_count--;
+    }
+    // 2. Carve from the newest slab, adding one when it is full
+    else
+    {
+        Slab *slab = a->slabs;
+        if (slab == NULL || slab->used == slab->capacity)
+        {
+            slab = add_slab(a, SLAB_NODES);
+            if (slab == NULL)
+                return NULL;
+        }
+        node = &slab->nodes[slab->used++];
+    }
+
+    memset(node, 0, sizeof(emp));
+    a->live++;
+    a->churn++;
+    return node;
+}
+
+emp *node_alloc_block(NodeAllocator *a, size_t count)
+{
+    if (count == 0)
+        return NULL;
+
+    Slab *slab = add_slab(a, count);
+    if (slab == NULL)
+        return NULL;
+
+    slab->used = count;
+    memset(slab->nodes, 0, count * sizeof(emp));
+    a->live += count;
+    return slab->nodes;
+}
+
+void node_release(NodeAllocator *a, emp *node)
+{
+    if (node == NULL)
+        return;
+
+    node->prev = NULL;
+    node->next = a->free_list;
+    a->free_list = node;
+    a->free_count++;
+    a->live--;
+    a->churn++;
+}
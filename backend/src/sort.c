@@ -0,0 +1,201 @@
+// File_Name sort.c
+// Cached sort permutations for sorted reads
+
+#include <strings.h>
+
+#include "sort.h"
+
+static const char *const FIELD_NAMES[] = {"id", "name", "age", "department", "salary"};
+
+void sort_cache_init(SortCache *c)
+{
+    memset(c, 0, sizeof(*c));
+}
+
+void sort_cache_free(SortCache *c)
+{
+    for (int i = 0; i < SORT_CACHE_SLOTS; i++)
+        free(c->slots[i].rows);
+    sort_cache_init(c);
+}
+
+int sort_key_parse(const char *fields, const char *order, SortKey *key)
+{
+    memset(key, 0, sizeof(*key));
+
+    if (order != NULL && strcasecmp(order, "desc") == 0)
+        key->descending = 1;
+    else if (order != NULL && strcasecmp(order, "asc") != 0)
+        return -1;
+
+    const char *p = fields;
+    while (1)
+    {
+        size_t len = strcspn(p, ",");
+        int field = -1;
+        for (int i = 0; i < (int)(sizeof(FIELD_NAMES) / sizeof(FIELD_NAMES[0])); i++)
+        {
+            if (strlen(FIELD_NAMES[i]) == len && strncasecmp(p, FIELD_NAMES[i], len) == 0)
+                field = i;
+        }
+        if (field < 0 || key->field_count == SORT_MAX_FIELDS)
+            return -1;
+
+        for (int i = 0; i < key->field_count; i++)
+        {
+            if (key->fields[i] == field)
+                return -1;
+        }
+        key->fields[key->field_count++] = field;
+
+        if (p[len] == '\0')
+            return 0;
+        p += len + 1;
+    }
+}
+
+// Helper: <0, 0, >0 like strcmp, with the key's order applied
+static int compare_rows(const emp *a, const emp *b, const SortKey *key)
+{
+    for (int i = 0; i < key->field_count; i++)
+    {
+        int diff;
+        switch (key->fields[i])
+        {
+        case SORT_ID:
+            diff = (a->id > b->id) - (a->id < b->id);
+            break;
+        case SORT_NAME:
+            diff = strcasecmp(a->name, b->name);
+            break;
+        case SORT_AGE:
+            diff = (a->age > b->age) - (a->age < b->age);
+            break;
+        case SORT_DEPARTMENT:
+            diff = strcasecmp(a->department, b->department);
+            break;
+        default:
+            diff = (a->salary > b->salary) - (a->salary < b->salary);
+            break;
+        }
+        if (diff != 0)
+            return key->descending ? -diff : diff;
+    }
+    return 0;
+}
+
+// Helper: bottom-up merge sort (stable, so equal rows stay in list order)
+static void merge_sort(emp **rows, emp **tmp, size_t count, const SortKey *key)
+{
+    emp **src = rows, **dst = tmp;
+    for (size_t width = 1; width < count; width *= 2)
+    {
+        for (size_t lo = 0; lo < count; lo += 2 * width)
+        {
+            size_t mid = lo + width < count ? lo + width : count;
+            size_t hi = lo + 2 * width < count ? lo + 2 * width : count;
+            size_t i = lo, j = mid, k = lo;
+
+            // Right side only wins when strictly smaller
+            while (i < mid && j < hi)
+                dst[k++] = compare_rows(src[j], src[i], key) < 0 ? src[j++] : src[i++];
+            while (i < mid)
+                dst[k++] = src[i++];
+            while (j < hi)
+                dst[k++] = src[j++];
+        }
+        emp **swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != rows)
+        memcpy(rows, src, count * sizeof(emp *));
+}
+
+static int same_key(const SortKey *a, const SortKey *b)
+{
+    return a->field_count == b->field_count && a->descending == b->descending &&
+           memcmp(a->fields, b->fields, a->field_count * sizeof(a->fields[0])) == 0;
+}
+
+SortedView *sort_cache_get(SortCache *c, const EmployeeList *list, size_t count,
+                           uint64_t version, const SortKey *key)
+{
+    SortedView *victim = NULL;
+    for (int i = 0; i < SORT_CACHE_SLOTS; i++)
+    {
+        SortedView *v = &c->slots[i];
+
+        // Versions only grow: an older permutation is never reused
+        if (v->rows != NULL && v->version != version && v->pins == 0)
+        {
+            free(v->rows);
+            v->rows = NULL;
+        }
+
+        if (v->rows != NULL && v->version == version && same_key(&v->key, key))
+        {
+            v->last_used = ++c->clock;
+            v->pins++;
+            return v;
+        }
+
+        if (v->pins > 0)
+            continue;
+        if (victim == NULL || (victim->rows != NULL && (v->rows == NULL || v->last_used < victim->last_used)))
+            victim = v;
+    }
+
+    int private_view = victim == NULL;
+    if (private_view)
+    {
+        victim = (SortedView *)calloc(1, sizeof(SortedView));
+        if (victim == NULL)
+            return NULL;
+    }
+
+    emp **rows = (emp **)malloc((count + 1) * sizeof(emp *));
+    emp **tmp = (emp **)malloc((count + 1) * sizeof(emp *));
+    if (rows == NULL || tmp == NULL)
+    {
+        free(rows);
+        free(tmp);
+        if (private_view)
+            free(victim);
+        return NULL;
+    }
+
+    size_t filled = 0;
+    for (emp *curr = list_first(list); curr != NULL && filled < count; curr = list_next(list, curr))
+        rows[filled++] = curr;
+
+    merge_sort(rows, tmp, filled, key);
+    free(tmp);
+
+    free(victim->rows);
+    victim->key = *key;
+    victim->version = version;
+    victim->rows = rows;
+    victim->count = filled;
+    victim->last_used = ++c->clock;
+    victim->pins = 1;
+    c->builds++;
+    return victim;
+}
+
+void sort_cache_release(SortCache *c, SortedView *view)
+{
+    for (int i = 0; i < SORT_CACHE_SLOTS; i++)
+    {
+        if (view == &c->slots[i])
+        {
+            view->pins--;
+            return;
+        }
+    }
+
+    // A private view (every slot was pinned when it was built)
+    free(view->rows);
+    free(view);
+}
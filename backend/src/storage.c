@@ -1,14 +1,27 @@
 // File_Name storage.c
 // Handles the binary database logics
 
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <pthread.h>
 
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "mongoose.h"
+#include "config.h"
 #include "employee.h"
 #include "storage.h"
 #include "table.h"
+#include "utils.h"
 
 // Protects users.bin and tables_registry.bin operations (exists in main.c)
 extern pthread_mutex_t file_registry_lock;
@@ -35,9 +48,9 @@ EmployeeRecord node_to_record(emp *node)
     }
     return rec;
 }
-emp *record_to_node(EmployeeRecord record)
+emp *record_to_node(NodeAllocator *nodes, EmployeeRecord record)
 {
-    emp *new_node = (emp *)calloc(1, sizeof(emp));
+    emp *new_node = node_alloc(nodes);
     if (!new_node)
     {
         return NULL;
@@ -49,83 +62,647 @@ emp *record_to_node(EmployeeRecord record)
     new_node->salary = record.salary;
 
     new_node->next = NULL;
+    new_node->prev = NULL;
 
     return new_node;
 }
 
-// --- TABLE FUNCTIONS ---
-void save_table_binary(Table *t)
+// --- DURABILITY HELPERS ---
+// Force a stream's buffered data all the way to the disk
+static int sync_file(FILE *fp)
 {
-    if (t == NULL)
+    if (fflush(fp) != 0)
+        return -1;
+#ifdef _WIN32
+    return _commit(_fileno(fp));
+#else
+    return fsync(fileno(fp));
+#endif
+}
+
+// Make a completed rename in 'dir' survive a power cut
+static void sync_dir(const char *dir)
+{
+#ifndef _WIN32
+    int fd = open(dir, O_RDONLY);
+    if (fd >= 0)
+    {
+        fsync(fd);
+        close(fd);
+    }
+#else
+    (void)dir;
+#endif
+}
+
+// rename() that replaces an existing target on every platform
+static int replace_file(const char *from, const char *to)
+{
+#ifdef _WIN32
+    remove(to);
+#endif
+    return rename(from, to);
+}
+
+// --- TABLE FILE HELPERS ---
+// CRC-32 (IEEE, reflected) with a lazily built byte table
+static uint32_t crc_table[256];
+static pthread_once_t crc_table_once = PTHREAD_ONCE_INIT;
+
+static void build_crc_table(void)
+{
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++)
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        crc_table[i] = c;
+    }
+}
+
+static uint32_t crc32_update(uint32_t crc, const void *buf, size_t len)
+{
+    // Tables load on worker threads, so build it exactly once
+    pthread_once(&crc_table_once, build_crc_table);
+
+    const unsigned char *p = (const unsigned char *)buf;
+    crc = ~crc;
+    while (len--)
+        crc = crc_table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+// Maps a whole file read-only. Returns NULL if it is missing or empty.
+static const unsigned char *map_file(const char *path, size_t *size)
+{
+    *size = 0;
+#ifdef _WIN32
+    // No mmap here: one bulk read into a single buffer instead
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL)
+        return NULL;
+    fseek(fp, 0, SEEK_END);
+    long len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    unsigned char *data = len > 0 ? (unsigned char *)malloc((size_t)len) : NULL;
+    if (data != NULL && fread(data, 1, (size_t)len, fp) != (size_t)len)
+    {
+        free(data);
+        data = NULL;
+    }
+    fclose(fp);
+    if (data != NULL)
+        *size = (size_t)len;
+    return data;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping stays valid after the descriptor is closed
+    if (data == MAP_FAILED)
+        return NULL;
+
+    madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+    *size = (size_t)st.st_size;
+    return (const unsigned char *)data;
+#endif
+}
+
+static void unmap_file(const unsigned char *data, size_t size)
+{
+#ifdef _WIN32
+    (void)size;
+    free((void *)data);
+#else
+    munmap((void *)data, size);
+#endif
+}
+
+/*
+ * Finds the record array inside a mapped table file.
+ * Returns the file's format version (1 = old headerless file), 0 if it is
+ * unreadable, truncated or fails its checksum.
+ * *data_version is the table version stored with it (0 before format v3).
+ */
+static int locate_records(int table_id, const unsigned char *data, size_t size,
+                          const EmployeeRecord **records, size_t *count, uint64_t *data_version)
+{
+    *records = NULL;
+    *count = 0;
+    *data_version = 0;
+
+    const TableFileHeader *hdr = (const TableFileHeader *)data;
+    if (size < TABLE_FILE_V2_HEADER_SIZE || memcmp(hdr->magic, TABLE_FILE_MAGIC, 4) != 0)
     {
+        // Version 1: the file is nothing but records
+        if (size % sizeof(EmployeeRecord) != 0)
+        {
+            printf("[STORAGE] Table %d: headerless file ends in a partial record.\n", table_id);
+            return 0;
+        }
+        *records = (const EmployeeRecord *)data;
+        *count = size / sizeof(EmployeeRecord);
+        return 1;
+    }
+
+    size_t header_size = hdr->version == 2 ? TABLE_FILE_V2_HEADER_SIZE : sizeof(TableFileHeader);
+    if ((hdr->version != 2 && hdr->version != TABLE_FILE_VERSION) || hdr->record_size != sizeof(EmployeeRecord) ||
+        size < header_size)
+    {
+        printf("[STORAGE] Table %d: unsupported file version %u (record size %u).\n",
+               table_id, hdr->version, hdr->record_size);
+        return 0;
+    }
+    if (hdr->version >= 3)
+        *data_version = hdr->data_version;
+
+    size_t available = (size - header_size) / sizeof(EmployeeRecord);
+    size_t rows = hdr->row_count;
+    if (rows > available)
+    {
+        printf("[STORAGE] Table %d: file truncated, %zu of %zu rows present.\n", table_id, available, rows);
+        return 0;
+    }
+
+    const EmployeeRecord *first = (const EmployeeRecord *)(data + header_size);
+    if (crc32_update(0, first, rows * sizeof(EmployeeRecord)) != hdr->checksum)
+    {
+        printf("[STORAGE] Table %d: checksum mismatch.\n", table_id);
+        return 0;
+    }
+
+    *records = first;
+    *count = rows;
+    return (int)hdr->version;
+}
+
+// Builds the list from mapped records in a single slab sized to the table
+static void link_records(Table *t, const EmployeeRecord *records, size_t count)
+{
+    if (count == 0)
+        return;
+
+    emp *block = node_alloc_block(&t->nodes, count);
+    if (block == NULL)
+    {
+        // Not enough contiguous memory: fall back to regular slabs
+        for (size_t i = 0; i < count; i++)
+        {
+            emp *node = record_to_node(&t->nodes, records[i]);
+            if (node)
+                insert_node_at_pos(t, node, -1);
+        }
         return;
     }
 
-    // 1. Generate filename based on Table ID
-    char filename[100];
-    snprintf(filename, sizeof(filename), "bin/tables/%d.bin", t->id);
+    for (size_t i = 0; i < count; i++)
+    {
+        emp *node = &block[i];
+        node->id = records[i].id;
+        node->age = records[i].age;
+        node->salary = records[i].salary;
+        memcpy(node->name, records[i].name, sizeof(node->name) - 1);
+        memcpy(node->department, records[i].department, sizeof(node->department) - 1);
+        node->next = (i + 1 < count) ? &block[i + 1] : NULL;
+        node->prev = (i > 0) ? &block[i - 1] : NULL;
+    }
+
+    if (t->employeelist.head == NULL)
+        t->employeelist.head = block;
+    else
+    {
+        t->employeelist.tail->next = block;
+        block->prev = t->employeelist.tail;
+    }
+    t->employeelist.tail = &block[count - 1];
+    skip_build(&t->skip, &t->employeelist);
+}
 
-    // 2. Open file for Writing Binary ("wb")
-    FILE *fp = fopen(filename, "wb");
+// --- TABLE FUNCTIONS ---
+/*
+ * A snapshot is written as <id>.bin.tmp, synced, then renamed to
+ * <id>.bin.ready. Once a .ready file exists it holds every logged
+ * mutation, so the WAL can be dropped and .ready promoted to <id>.bin.
+ * A crash anywhere in between is finished on the next load.
+ */
+static int save_table_binary(Table *t)
+{
+    // 1. Generate filenames based on Table ID
+    char tmp_name[100], ready_name[100];
+    snprintf(tmp_name, sizeof(tmp_name), "bin/tables/%d.bin.tmp", t->id);
+    snprintf(ready_name, sizeof(ready_name), "bin/tables/%d.bin.ready", t->id);
+
+    // 2. Open temp file for Writing Binary ("wb")
+    FILE *fp = fopen(tmp_name, "wb");
     if (fp == NULL)
     {
         // Try creating the folder if it fails (system command)
         system("mkdir -p bin/tables");
-        fp = fopen(filename, "wb");
+        fp = fopen(tmp_name, "wb");
         if (fp == NULL)
         {
             perror("Failed to open file for writing");
-            return;
+            return -1;
         }
     }
-    // 3. Traverse the list and write records
-    emp *current = t->employeelist.head;
-    while (current != NULL)
+
+    // 3. Header first (row count and checksum are patched in afterwards)
+    TableFileHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, TABLE_FILE_MAGIC, 4);
+    hdr.version = TABLE_FILE_VERSION;
+    hdr.record_size = sizeof(EmployeeRecord);
+    hdr.data_version = t->version;
+
+    int ok = fwrite(&hdr, sizeof(hdr), 1, fp) == 1;
+
+    // 4. Traverse the list and write records (in the order clients see, so a
+    //    reloaded table starts out unreversed)
+    emp *current = list_first(&t->employeelist);
+    while (ok && current != NULL)
     {
         EmployeeRecord rec = node_to_record(current);
-        fwrite(&rec, sizeof(EmployeeRecord), 1, fp);
-        current = current->next;
+        if (fwrite(&rec, sizeof(EmployeeRecord), 1, fp) != 1)
+        {
+            ok = 0;
+            break;
+        }
+        hdr.checksum = crc32_update(hdr.checksum, &rec, sizeof(rec));
+        hdr.row_count++;
+        current = list_next(&t->employeelist, current);
     }
+
+    if (ok)
+        ok = fseek(fp, 0, SEEK_SET) == 0 && fwrite(&hdr, sizeof(hdr), 1, fp) == 1;
+
+    // 5. Only a fully synced file may replace the old snapshot
+    if (sync_file(fp) != 0)
+        ok = 0;
     fclose(fp);
-    printf("Table '%d' saved to disk.\n", t->id);
+
+    if (!ok || replace_file(tmp_name, ready_name) != 0)
+    {
+        perror("Failed to write table snapshot");
+        remove(tmp_name);
+        return -1;
+    }
+    sync_dir("bin/tables");
+    return 0;
+}
+
+// Drops the log and makes <id>.bin.ready the live snapshot. Returns 1 if one was promoted.
+static int promote_snapshot(int table_id)
+{
+    char ready_name[100], bin_name[100], wal_name[100];
+    snprintf(ready_name, sizeof(ready_name), "bin/tables/%d.bin.ready", table_id);
+    snprintf(bin_name, sizeof(bin_name), "bin/tables/%d.bin", table_id);
+    snprintf(wal_name, sizeof(wal_name), "bin/tables/%d.wal", table_id);
+
+    FILE *fp = fopen(ready_name, "rb");
+    if (fp == NULL)
+    {
+        return 0;
+    }
+    fclose(fp);
+
+    // The ready snapshot already contains everything in the log
+    remove(wal_name);
+    replace_file(ready_name, bin_name);
+    sync_dir("bin/tables");
+    return 1;
 }
 
 // Loads data from a binary file into the table's linked list
-void load_table_binary(Table *t)
+int load_table_binary(Table *t)
 {
     // 1. Generate filename
     char filename[100];
     snprintf(filename, sizeof(filename), "bin/tables/%d.bin", t->id);
 
-    // 2. Open file for Reading Binary ("rb")
-    FILE *fp = fopen(filename, "rb");
+    // Finish a checkpoint that crashed after its snapshot was made durable
+    if (promote_snapshot(t->id))
+        printf("[STORAGE] Table %d: completed interrupted checkpoint.\n", t->id);
+
+    // 2. Map the snapshot and link its records in place of per-row reads
+    int version = TABLE_FILE_VERSION;
+    size_t size = 0;
+    const unsigned char *data = map_file(filename, &size);
+    if (data != NULL)
+    {
+        const EmployeeRecord *records;
+        size_t count;
+        uint64_t data_version;
+        version = locate_records(t->id, data, size, &records, &count, &data_version);
+        if (version == 0)
+        {
+            // Serving what is left would let the next checkpoint overwrite the file for good
+            unmap_file(data, size);
+            printf("[STORAGE] Table %d: snapshot damaged, not loading it (%s kept as is).\n", t->id, filename);
+            return -1;
+        }
+        link_records(t, records, count);
+        t->version = data_version; // Replay below bumps it once per logged change, as the handlers did
+        unmap_file(data, size);
+    }
+    id_index_build(&t->id_index, t->employeelist.head);
+
+    // 3. Replay mutations logged since that snapshot
+    wal_replay(t);
+
+    // 4. Upgrade files written before the header existed
+    if (version == 1)
+    {
+        printf("[STORAGE] Table %d: upgrading to file format v%d.\n", t->id, TABLE_FILE_VERSION);
+        checkpoint_table(t);
+    }
+    return 0;
+}
+
+// --- WRITE-AHEAD LOG ---
+static void wal_filename(int table_id, char *buffer, size_t size)
+{
+    snprintf(buffer, size, "bin/tables/%d.wal", table_id);
+}
+
+// CRC of everything in the record before the crc field itself
+static uint32_t wal_crc(const WalRecord *rec)
+{
+    return crc32_update(0, rec, offsetof(WalRecord, crc));
+}
+
+// Cuts an open file back to 'size' bytes. Returns 0 on success.
+static int truncate_file(FILE *fp, long size)
+{
+    clearerr(fp);
+#ifdef _WIN32
+    if (_chsize(_fileno(fp), size) != 0)
+        return -1;
+#else
+    if (ftruncate(fileno(fp), (off_t)size) != 0)
+        return -1;
+#endif
+    return fseek(fp, 0, SEEK_END);
+}
+
+// Applies one logged mutation to the in-memory list
+static void wal_apply(Table *t, const WalRecord *rec)
+{
+    emp *node;
+    switch (rec->op)
+    {
+    case WAL_INSERT:
+        node = record_to_node(&t->nodes, rec->data);
+        if (node)
+            insert_node_at_pos(t, node, rec->position);
+        break;
+    case WAL_DELETE:
+        free_node(t, detach_node_by_id(t, rec->target_id));
+        break;
+    case WAL_UPDATE:
+        free_node(t, detach_node_by_id(t, rec->target_id));
+        node = record_to_node(&t->nodes, rec->data);
+        if (node)
+            insert_node_at_pos(t, node, rec->position);
+        break;
+    case WAL_REVERSE:
+        reverse_list(t);
+        break;
+    }
+}
+
+void wal_replay(Table *t)
+{
+    char filename[100];
+    wal_filename(t->id, filename, sizeof(filename));
+
+    FILE *fp = fopen(filename, "rb+");
     if (fp == NULL)
     {
         return;
     }
-    EmployeeRecord rec;
-    while (fread(&rec, sizeof(EmployeeRecord), 1, fp))
+
+    WalRecord rec;
+    size_t bytes = 0;
+    int torn = 0;
+    while (fread(&rec, sizeof(WalRecord), 1, fp))
     {
-        emp *new_node = record_to_node(rec);
-        if (new_node == NULL)
-            continue;
+        // A record that doesn't match its CRC was never fully written: nothing after it counts
+        if (rec.crc != wal_crc(&rec))
+        {
+            torn = 1;
+            break;
+        }
 
-        if (t->employeelist.head == NULL)
+        if (rec.op == WAL_BATCH)
         {
-            t->employeelist.head = new_node;
-            t->employeelist.tail = new_node;
+            // Apply a batch only once every one of its records is on disk
+            int n = rec.target_id;
+            WalRecord *group = (n > 0 && n <= WAL_BATCH_MAX_RECORDS) ? (WalRecord *)malloc(n * sizeof(WalRecord)) : NULL;
+            int whole = group != NULL && fread(group, sizeof(WalRecord), n, fp) == (size_t)n;
+            for (int i = 0; whole && i < n; i++)
+                whole = group[i].crc == wal_crc(&group[i]);
+            if (!whole)
+            {
+                free(group);
+                torn = 1;
+                break;
+            }
+            for (int i = 0; i < n; i++)
+                wal_apply(t, &group[i]);
+            free(group);
+            t->wal_records += n + 1;
+            bytes += (n + 1) * sizeof(WalRecord);
+            continue;
         }
-        else
+
+        wal_apply(t, &rec);
+        t->wal_records++;
+        bytes += sizeof(WalRecord);
+    }
+
+    // A crash mid-append leaves a torn record (or batch) at the end. fread()
+    // consumed its bytes without returning it, so compare positions.
+    if (!torn)
+        torn = ftell(fp) != (long)bytes;
+
+    if (torn)
+    {
+        // Fold what we recovered into a snapshot so new appends start clean
+        printf("[STORAGE] Table %d: discarded torn WAL tail after %zu bytes.\n", t->id, bytes);
+        if (checkpoint_table(t) != 0)
         {
-            t->employeelist.tail->next = new_node;
-            t->employeelist.tail = new_node;
+            // No snapshot: the log stays, so appends must follow its last whole record
+            if (truncate_file(fp, (long)bytes) != 0 || sync_file(fp) != 0)
+            {
+                printf("[STORAGE] Table %d: can't cut the WAL back, writes go to snapshots until one succeeds.\n", t->id);
+                t->wal_broken = 1;
+            }
         }
     }
     fclose(fp);
 }
 
+// Appends whole records or nothing. Returns 0 once they are durable as the
+// durability mode promises (in the log, or failing that in a snapshot).
+static int wal_append(Table *t, WalRecord *rec, int count)
+{
+    t->dirty = 1; // Whatever happens below, the snapshot is behind until a checkpoint
+
+    // Log can't be trusted to end cleanly: every write takes a snapshot instead
+    if (t->wal_broken)
+        return checkpoint_table(t);
+
+    if (t->wal_fp == NULL)
+    {
+        char filename[100];
+        wal_filename(t->id, filename, sizeof(filename));
+
+        t->wal_fp = fopen(filename, "ab");
+        if (t->wal_fp == NULL)
+        {
+            system("mkdir -p bin/tables");
+            t->wal_fp = fopen(filename, "ab");
+        }
+        if (t->wal_fp == NULL)
+        {
+            // Can't log: fall back to a full snapshot so nothing is lost
+            perror("Failed to open WAL for appending");
+            return checkpoint_table(t);
+        }
+        fseek(t->wal_fp, 0, SEEK_END);
+    }
+
+    for (int i = 0; i < count; i++)
+        rec[i].crc = wal_crc(&rec[i]);
+
+    long good = ftell(t->wal_fp); // End of the last whole record
+    int failed = good < 0 ||
+                 fwrite(rec, sizeof(WalRecord), count, t->wal_fp) != (size_t)count ||
+                 fflush(t->wal_fp) != 0 ||
+                 (server_config.durability == DURABILITY_SYNC && sync_file(t->wal_fp) != 0);
+    if (failed)
+    {
+        // Cut the partial write off so later appends follow a whole record,
+        // then let a snapshot hold the change instead
+        perror("Failed to append to WAL");
+        if (good < 0 || truncate_file(t->wal_fp, good) != 0)
+            t->wal_broken = 1;
+        return checkpoint_table(t);
+    }
+
+    t->wal_records += count;
+
+    // The checkpointer thread takes care of group commit and snapshots
+    if (server_config.durability == DURABILITY_GROUP)
+        t->wal_unsynced = 1;
+    return 0;
+}
+
+int wal_log_insert(Table *t, emp *node, int position)
+{
+    WalRecord rec = {WAL_INSERT, 0, position, node_to_record(node)};
+    return wal_append(t, &rec, 1);
+}
+
+int wal_log_delete(Table *t, int target_id)
+{
+    WalRecord rec = {WAL_DELETE, target_id, -1, node_to_record(NULL)};
+    return wal_append(t, &rec, 1);
+}
+
+int wal_log_update(Table *t, int original_id, emp *node, int position)
+{
+    WalRecord rec = {WAL_UPDATE, original_id, position, node_to_record(node)};
+    return wal_append(t, &rec, 1);
+}
+
+int wal_log_reverse(Table *t)
+{
+    WalRecord rec = {WAL_REVERSE, 0, -1, node_to_record(NULL)};
+    return wal_append(t, &rec, 1);
+}
+
+int wal_log_batch(Table *t, const WalRecord *records, int count)
+{
+    if (count <= 0)
+        return 0;
+
+    // Header + records in one buffer so they reach the file in one write
+    WalRecord *group = (WalRecord *)malloc((count + 1) * sizeof(WalRecord));
+    if (group == NULL)
+    {
+        // Can't frame the batch: a snapshot holds it just as well
+        return checkpoint_table(t);
+    }
+
+    WalRecord header = {WAL_BATCH, count, -1, node_to_record(NULL)};
+    group[0] = header;
+    memcpy(&group[1], records, count * sizeof(WalRecord));
+    int rc = wal_append(t, group, count + 1);
+    free(group);
+    return rc;
+}
+
+void wal_close(Table *t)
+{
+    if (t->wal_fp != NULL)
+    {
+        fclose(t->wal_fp);
+        t->wal_fp = NULL;
+    }
+}
+
+void wal_sync(Table *t)
+{
+    if (t->wal_unsynced && t->wal_fp != NULL && sync_file(t->wal_fp) != 0)
+    {
+        // Still unsynced: the next tick tries again, and a checkpoint covers it as well
+        perror("Failed to sync WAL");
+        return;
+    }
+    t->wal_unsynced = 0;
+}
+
+int checkpoint_table(Table *t)
+{
+    if (t == NULL)
+    {
+        return -1;
+    }
+
+    // 1. Everything in the log becomes part of a durable snapshot...
+    if (save_table_binary(t) != 0)
+    {
+        // Keep the log: it is still the only durable copy of recent writes
+        wal_sync(t);
+        return -1;
+    }
+
+    // 2. ...so the log can start over empty and the snapshot take over
+    wal_close(t);
+    promote_snapshot(t->id);
+
+    t->wal_records = 0;
+    t->wal_unsynced = 0;
+    t->wal_broken = 0; // promote_snapshot() removed the log, the next append starts a clean one
+    t->dirty = 0;
+    t->last_checkpoint_ms = mg_millis();
+    printf("Table '%d' saved to disk.\n", t->id);
+    return 0;
+}
+
 // --- USER FUNCTIONS ---
-User find_user_by_name(const char* username){
+// Helper: scan users.bin (caller holds file_registry_lock)
+static User lookup_user(const char* username){
     FILE *fp = fopen("bin/users/users.bin", "rb");
     User user;
     User not_found = {-1, "", ""};
@@ -141,12 +718,20 @@ User find_user_by_name(const char* username){
     return not_found;
 }
 
+User find_user_by_name(const char* username){
+    // Registrations append to the file from other threads
+    pthread_mutex_lock(&file_registry_lock);
+    User user = lookup_user(username);
+    pthread_mutex_unlock(&file_registry_lock);
+    return user;
+}
+
 int save_new_user(const char* username, const char *hash){
 
     pthread_mutex_lock(&file_registry_lock);
 
     // A. Check for Duplicates
-    User check = find_user_by_name(username);
+    User check = lookup_user(username);
     if (check.id != -1) {
         pthread_mutex_unlock(&file_registry_lock);
         return -1;
@@ -276,9 +861,11 @@ TableMetadata* get_user_tables(int user_id, int *count) {
     return list;
 }
 
-int is_table_owner(int user_id, int table_id) {
+int is_table_owner_locked(int user_id, int table_id) {
     FILE *fp = fopen("bin/users/tables_registry.bin", "rb");
-    if (!fp) return 0;
+    if (!fp) {
+        return 0;
+    }
 
     TableMetadata temp;
     int found = 0;
@@ -292,16 +879,20 @@ int is_table_owner(int user_id, int table_id) {
     return found;
 }
 
-int delete_table_permanently(int table_id, int owner_id) {
-    unload_table(table_id);
+int is_table_owner(int user_id, int table_id) {
+    // delete_table_permanently() swaps the registry file from other threads
     pthread_mutex_lock(&file_registry_lock);
+    int found = is_table_owner_locked(user_id, table_id);
+    pthread_mutex_unlock(&file_registry_lock);
+    return found;
+}
 
-    // 1. Delete the physical data file (The BIN with employee data)
-    char filename[100];
-    snprintf(filename, sizeof(filename), "bin/tables/%d.bin", table_id);
-    remove(filename); // Returns non-zero on fail, but we continue anyway to clean registry
+int delete_table_permanently(int table_id, int owner_id) {
+    pthread_mutex_lock(&file_registry_lock);
 
-    // 2. Rewrite Registry to remove metadata (Copy-Swap Method)
+    // 1. Rewrite Registry with the row retired (Copy-Swap Method). The row stays
+    // as a tombstone: ids are handed out past the highest one in the file, so
+    // this id never comes back for a new table whose files step 4 would remove.
     FILE *fp = fopen("bin/users/tables_registry.bin", "rb");
     if (!fp) {
         pthread_mutex_unlock(&file_registry_lock);
@@ -318,10 +909,10 @@ int delete_table_permanently(int table_id, int owner_id) {
     TableMetadata meta;
     int found = 0;
     while(fread(&meta, sizeof(TableMetadata), 1, fp)) {
-        // If ID matches AND Owner matches, we SKIP writing it (Deleting it)
-        if (meta.id == table_id && meta.owner_id == owner_id) {
+        // If ID matches AND Owner matches, it is written back inactive (Deleting it)
+        if (meta.id == table_id && meta.owner_id == owner_id && meta.is_active == 1) {
             found = 1;
-            continue; 
+            meta.is_active = 0;
         }
         fwrite(&meta, sizeof(TableMetadata), 1, temp);
     }
@@ -329,15 +920,29 @@ int delete_table_permanently(int table_id, int owner_id) {
     fclose(fp);
     fclose(temp);
 
-    // 3. Swap Files
-    if (found) {
-        remove("bin/users/tables_registry.bin");
-        rename("bin/users/temp_registry.bin", "bin/users/tables_registry.bin");
-        printf("[STORAGE] Table %d deleted permanently.\n", table_id);
-    } else {
+    // 2. Swap Files
+    if (!found) {
         remove("bin/users/temp_registry.bin"); // Cleanup temp if nothing found
+        pthread_mutex_unlock(&file_registry_lock);
+        return -3; // Not found (or not this owner's): its data stays
     }
-
+    remove("bin/users/tables_registry.bin");
+    rename("bin/users/temp_registry.bin", "bin/users/tables_registry.bin");
     pthread_mutex_unlock(&file_registry_lock);
-    return found ? 0 : -3; // 0 success, -3 not found
+
+    // 3. Drop it from RAM. The row is retired, so no request can load it again
+    // (get_or_load_table() checks the registry under the same lock); this
+    // only waits for the requests already holding it.
+    unload_table(table_id);
+
+    // 4. Delete the physical data files (snapshot, log, half-written snapshots)
+    const char *suffixes[] = {"bin", "wal", "bin.ready", "bin.tmp"};
+    char filename[100];
+    for (int i = 0; i < 4; i++) {
+        snprintf(filename, sizeof(filename), "bin/tables/%d.%s", table_id, suffixes[i]);
+        remove(filename);
+    }
+
+    printf("[STORAGE] Table %d deleted permanently.\n", table_id);
+    return 0;
 }
\ No newline at end of file
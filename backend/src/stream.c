@@ -0,0 +1,221 @@
+// File_Name stream.c
+// Chunked JSON writer that encodes rows directly into the send buffer
+
+#include "stream.h"
+
+#define STREAM_CHUNK_BYTES 32768    // Close a chunk once it holds this much
+#define CHUNK_SIZE_FIELD 10         // "%08x\r\n" placeholder in front of every chunk
+#define ROW_MAX_BYTES 768           // Longest possible encoded row (fully escaped strings)
+
+static const char HEX[] = "0123456789abcdef";
+
+// Helper: make room for 'n' more bytes and return where to write them.
+// mg_iobuf_resize copies the whole buffer, so grow geometrically.
+static char *reserve(JsonStream *js, size_t n)
+{
+    struct mg_iobuf *io = &js->c->send;
+    if (js->failed)
+        return NULL;
+
+    if (io->len + n > io->size)
+    {
+        size_t size = io->size ? io->size * 2 : 65536;
+        while (size < io->len + n)
+            size *= 2;
+        if (!mg_iobuf_resize(io, size))
+        {
+            js->failed = 1;
+            return NULL;
+        }
+    }
+    return (char *)io->buf + io->len;
+}
+
+static void open_chunk(JsonStream *js)
+{
+    char *out = reserve(js, CHUNK_SIZE_FIELD);
+    if (out == NULL)
+        return;
+    js->chunk_start = js->c->send.len;
+    memcpy(out, "00000000\r\n", CHUNK_SIZE_FIELD);
+    js->c->send.len += CHUNK_SIZE_FIELD;
+}
+
+// Helper: patch the open chunk's size; empty chunks are dropped (a zero
+// size would end the body early)
+static void close_chunk(JsonStream *js)
+{
+    struct mg_iobuf *io = &js->c->send;
+    if (js->failed)
+        return;
+
+    size_t payload = io->len - js->chunk_start - CHUNK_SIZE_FIELD;
+    if (payload == 0)
+    {
+        io->len = js->chunk_start;
+        return;
+    }
+
+    // Chunks stay far below 4 GB, so 8 hex digits always fit
+    char *size_field = (char *)io->buf + js->chunk_start;
+    for (int i = 7; i >= 0; i--, payload >>= 4)
+        size_field[i] = HEX[payload & 0xF];
+
+    char *out = reserve(js, 2);
+    if (out == NULL)
+        return;
+    memcpy(out, "\r\n", 2);
+    io->len += 2;
+}
+
+// Helper: roll over to a new chunk once the current one is big enough
+static void maybe_rotate(JsonStream *js)
+{
+    if (!js->failed && js->c->send.len - js->chunk_start >= STREAM_CHUNK_BYTES)
+    {
+        close_chunk(js);
+        open_chunk(js);
+    }
+}
+
+static char *put_int(char *out, int value)
+{
+    char digits[12];
+    int n = 0;
+    unsigned int magnitude = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+
+    do
+    {
+        digits[n++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    if (value < 0)
+        *out++ = '-';
+    while (n > 0)
+        *out++ = digits[--n];
+    return out;
+}
+
+// Same escaping rules as cJSON's printer
+static char *put_string(char *out, const char *str, size_t max)
+{
+    *out++ = '"';
+    for (size_t i = 0; i < max && str[i] != '\0'; i++)
+    {
+        unsigned char ch = (unsigned char)str[i];
+        switch (ch)
+        {
+        case '"': *out++ = '\\'; *out++ = '"'; break;
+        case '\\': *out++ = '\\'; *out++ = '\\'; break;
+        case '\b': *out++ = '\\'; *out++ = 'b'; break;
+        case '\f': *out++ = '\\'; *out++ = 'f'; break;
+        case '\n': *out++ = '\\'; *out++ = 'n'; break;
+        case '\r': *out++ = '\\'; *out++ = 'r'; break;
+        case '\t': *out++ = '\\'; *out++ = 't'; break;
+        default:
+            if (ch < 0x20)
+            {
+                memcpy(out, "\\u00", 4);
+                out[4] = HEX[ch >> 4];
+                out[5] = HEX[ch & 0xF];
+                out += 6;
+            }
+            else
+            {
+                *out++ = (char)ch;
+            }
+        }
+    }
+    *out++ = '"';
+    return out;
+}
+
+void json_stream_begin(JsonStream *js, struct mg_connection *c, const char *extra_headers)
+{
+    js->c = c;
+    js->chunk_start = 0;
+    js->need_comma = 0;
+    js->failed = 0;
+
+    mg_printf(c, "HTTP/1.1 200 OK\r\n"
+                 "Access-Control-Allow-Origin: *\r\n"
+                 "Content-Type: application/json\r\n"
+                 "Transfer-Encoding: chunked\r\n%s\r\n", extra_headers ? extra_headers : "");
+    open_chunk(js);
+}
+
+void json_stream_text(JsonStream *js, const char *text)
+{
+    size_t len = strlen(text);
+    char *out = reserve(js, len);
+    if (out == NULL)
+        return;
+    memcpy(out, text, len);
+    js->c->send.len += len;
+    js->need_comma = 0;
+    maybe_rotate(js);
+}
+
+void json_stream_string(JsonStream *js, const char *str)
+{
+    if (str == NULL)
+    {
+        json_stream_text(js, "null");
+        return;
+    }
+
+    size_t len = strlen(str);
+    char *out = reserve(js, len * 6 + 2);
+    if (out == NULL)
+        return;
+    char *end = put_string(out, str, len);
+    js->c->send.len += (size_t)(end - out);
+    maybe_rotate(js);
+}
+
+void json_stream_row(JsonStream *js, int id, const char *name, int age, const char *dept, int salary)
+{
+    char *out = reserve(js, ROW_MAX_BYTES);
+    if (out == NULL)
+        return;
+
+    char *p = out;
+    if (js->need_comma)
+        *p++ = ',';
+
+    memcpy(p, "{\"id\":", 6), p += 6;
+    p = put_int(p, id);
+    memcpy(p, ",\"name\":", 8), p += 8;
+    p = put_string(p, name, 49);
+    memcpy(p, ",\"age\":", 7), p += 7;
+    p = put_int(p, age);
+    memcpy(p, ",\"department\":", 14), p += 14;
+    p = put_string(p, dept, 49);
+    memcpy(p, ",\"salary\":", 10), p += 10;
+    p = put_int(p, salary);
+    *p++ = '}';
+
+    js->c->send.len += (size_t)(p - out);
+    js->need_comma = 1;
+    maybe_rotate(js);
+}
+
+void json_stream_end(JsonStream *js)
+{
+    close_chunk(js);
+
+    char *out = reserve(js, 5);
+    if (out != NULL)
+    {
+        memcpy(out, "0\r\n\r\n", 5);
+        js->c->send.len += 5;
+    }
+
+    if (js->failed)
+    {
+        // Can't finish a half-sent body: drop the connection instead
+        printf("[STREAM] Out of memory while writing a response, closing connection\n");
+        js->c->is_closing = 1;
+    }
+}
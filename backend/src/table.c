@@ -1,101 +1,405 @@
 // File_Name table.c
+#include "mongoose.h"
 #include "table.h"
 #include "storage.h"
+#include "utils.h"
 
-// Global Head of the "List of Lists"
-Table *global_tables_head = NULL;
+extern pthread_mutex_t file_registry_lock;
 
-// Global Lock
-pthread_mutex_t global_list_lock = PTHREAD_MUTEX_INITIALIZER;
+// --- TABLE DIRECTORY ---
+// Loaded tables by id: a fixed array of hash buckets (chained through
+// Table.next), each guarded by one of TABLE_STRIPES locks. Resolving a table
+// locks a single stripe, so requests for unrelated tenants rarely meet.
+// The stripe lock also guards the refs / referenced / loading fields of its
+// tables. A cold table is linked in as a 'loading' placeholder and read from
+// disk with the stripe unlocked: lookups of other tables go ahead, and
+// requests for the same table wait for that one load instead of starting their own.
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t changed;     // Broadcast when a load finishes or a table's refs drop to 0
+} TableStripe;
 
-Table *get_or_load_table(int table_id, int owner_id)
+static Table *table_buckets[TABLE_BUCKETS];
+static TableStripe table_stripes[TABLE_STRIPES];
+static pthread_once_t directory_once = PTHREAD_ONCE_INIT;
+
+// CLOCK hand for pick_cold_table() (only the checkpointer sweeps)
+static size_t clock_hand = 0;
+
+static void init_directory(void)
+{
+    for (int i = 0; i < TABLE_STRIPES; i++)
+    {
+        pthread_mutex_init(&table_stripes[i].lock, NULL);
+        pthread_cond_init(&table_stripes[i].changed, NULL);
+    }
+}
+
+// Helper: Fibonacci hashing spreads the sequential ids (1001, 1002, ...) evenly
+static size_t bucket_of(int table_id)
+{
+    return (size_t)(((uint32_t)table_id * 2654435761u) >> (32 - TABLE_BUCKET_BITS));
+}
+
+static TableStripe *stripe_of(size_t bucket)
+{
+    pthread_once(&directory_once, init_directory);
+    return &table_stripes[bucket % TABLE_STRIPES];
+}
+
+// Helper: the link pointing at 't' in its bucket (NULL once it was unlinked)
+static Table **link_of(size_t bucket, const Table *t)
+{
+    Table **link = &table_buckets[bucket];
+    while (*link != NULL && *link != t)
+        link = &(*link)->next;
+    return *link != NULL ? link : NULL;
+}
+
+// Helper: Non-zero random tag for one load of a table
+static uint32_t new_epoch(void)
 {
+    uint32_t epoch = 0;
+    while (epoch == 0)
+    {
+        if (!mg_random(&epoch, sizeof(epoch)))
+            epoch = (uint32_t)mg_millis() ^ (uint32_t)(uintptr_t)&epoch;
+    }
+    return epoch;
+}
 
-    // --- STEP A: Thread Safety ---
-    int lock_res = pthread_mutex_lock(&global_list_lock);
+// Helper: the loaded table with this id (caller holds the bucket's stripe)
+static Table *find_in_bucket(size_t bucket, int table_id)
+{
+    for (Table *t = table_buckets[bucket]; t != NULL; t = t->next)
+    {
+        if (t->id == table_id)
+            return t;
+    }
+    return NULL;
+}
+
+// Helper: Writers go first once they wait, so a stream of readers can't starve them
+static int init_table_locks(Table *t)
+{
+    pthread_rwlockattr_t attr;
+    pthread_rwlockattr_init(&attr);
+#ifdef __GLIBC__
+    pthread_rwlockattr_setkind_np(&attr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+#endif
+    int rc = pthread_rwlock_init(&t->lock, &attr);
+    pthread_rwlockattr_destroy(&attr);
+    if (rc != 0)
+        return -1;
+
+    if (pthread_mutex_init(&t->build_lock, NULL) != 0)
+    {
+        pthread_rwlock_destroy(&t->lock);
+        return -1;
+    }
+    return 0;
+}
+
+// Helper: Free everything of a table nobody can reach any more
+static void destroy_table(Table *t)
+{
+    // Rows go slab by slab and towers chunk by chunk: no list walk
+    skip_free(&t->skip);
+    node_alloc_destroy(&t->nodes);
+    id_index_free(&t->id_index);
+    columns_free(&t->columns);
+    trigram_free(&t->trigrams);
+    range_index_free(&t->age_index);
+    range_index_free(&t->salary_index);
+    agg_free(&t->dept_stats);
+    sort_cache_free(&t->sorts);
+    frozen_release(t->frozen); // Readers still streaming it keep their reference
+    change_ring_free(&t->changes);
+    // Cleanup table resources
+    wal_close(t);
+    pthread_rwlock_destroy(&t->lock);
+    pthread_mutex_destroy(&t->build_lock);
+    free(t);
+}
+
+Table *get_or_load_table(int table_id, int owner_id, int *status)
+{
+    size_t bucket = bucket_of(table_id);
+    TableStripe *stripe = stripe_of(bucket);
+
+    // --- STEP A: Thread Safety (only this table's stripe) ---
+    pthread_mutex_lock(&stripe->lock);
 
     // --- STEP B: Search RAM ---
-    Table *current = global_tables_head;
-    while (current != NULL)
+    Table *current = find_in_bucket(bucket, table_id);
+    if (current == NULL)
     {
-        if (current->id == table_id)
+        // Cold (or evicted): only the registry may say who owns it. Checked
+        // with the stripe free, it reads a file. The registry stays locked
+        // until the stripe is ours again, so a delete either retires the row
+        // first (403 here) or finds the placeholder linked below and unloads it.
+        pthread_mutex_unlock(&stripe->lock);
+        pthread_mutex_lock(&file_registry_lock);
+        int owned = is_table_owner_locked(owner_id, table_id);
+        if (owned)
+            pthread_mutex_lock(&stripe->lock);
+        pthread_mutex_unlock(&file_registry_lock);
+        if (!owned)
         {
-            if (current->owner_id == owner_id)
-            {
-                pthread_mutex_unlock(&global_list_lock);
-                return current;
-            }
-            else
-            {
-                pthread_mutex_unlock(&global_list_lock);
-                return NULL; // Access Denied
-            }
+            *status = 403; // Access Denied
+            return NULL;
+        }
+        current = find_in_bucket(bucket, table_id); // Another request may have loaded it meanwhile
+    }
+
+    if (current != NULL)
+    {
+        if (current->owner_id != owner_id)
+        {
+            pthread_mutex_unlock(&stripe->lock);
+            *status = 403; // Access Denied
+            return NULL;
+        }
+        current->refs++;
+        current->referenced = 1;
+
+        // Someone else is reading it from disk: wait for that load
+        while (current->loading)
+            pthread_cond_wait(&stripe->changed, &stripe->lock);
+        if (current->load_failed)
+        {
+            // The loader unlinked it and frees it once everyone let go
+            current->refs--;
+            pthread_cond_broadcast(&stripe->changed);
+            pthread_mutex_unlock(&stripe->lock);
+            *status = 503;
+            return NULL;
         }
-        current = current->next;
+        pthread_mutex_unlock(&stripe->lock);
+        return current;
     }
 
     // --- STEP C: Not found in RAM, Create New ---
     Table *new_table = (Table *)malloc(sizeof(Table));
     if (!new_table)
     {
-        pthread_mutex_unlock(&global_list_lock);
+        pthread_mutex_unlock(&stripe->lock);
+        *status = 500;
         return NULL;
     }
 
     new_table->id = table_id;
     new_table->owner_id = owner_id;
-    // STEP D: Initialize table-specific lock
-    if (pthread_mutex_init(&new_table->lock, NULL) != 0)
+    // STEP D: Initialize table-specific locks
+    if (init_table_locks(new_table) != 0)
     {
         free(new_table);
-        pthread_mutex_unlock(&global_list_lock);
+        pthread_mutex_unlock(&stripe->lock);
+        *status = 500;
         return NULL;
     }
 
     init_employee_list(&new_table->employeelist);
+    skip_init(&new_table->skip);
+    node_alloc_init(&new_table->nodes);
+    id_index_init(&new_table->id_index);
+    columns_init(&new_table->columns);
+    trigram_init(&new_table->trigrams);
+    range_index_init(&new_table->age_index);
+    range_index_init(&new_table->salary_index);
+    agg_init(&new_table->dept_stats);
+    sort_cache_init(&new_table->sorts);
+    new_table->frozen = NULL;
+    new_table->wal_fp = NULL;
+    new_table->wal_records = 0;
+    new_table->wal_unsynced = 0;
+    new_table->wal_broken = 0;
+    new_table->dirty = 0;
+    new_table->version = 0;
+    new_table->epoch = new_epoch();
+    change_ring_init(&new_table->changes);
+    new_table->last_checkpoint_ms = mg_millis();
+    new_table->refs = 1; // The caller's
+    new_table->referenced = 1;
+    new_table->memory = 0;
+    atomic_init(&new_table->unflushed, 1); // First tick measures it
+    new_table->loading = 1;
+    new_table->load_failed = 0;
 
-    // Load data from disk
-    load_table_binary(new_table);
+    // Add to the head of its bucket as a placeholder, so later requests wait for this load
+    new_table->next = table_buckets[bucket];
+    table_buckets[bucket] = new_table;
+    pthread_mutex_unlock(&stripe->lock);
 
-    // Add to head of global list
-    new_table->next = global_tables_head;
-    global_tables_head = new_table;
+    // --- STEP E: Load data from disk with the stripe free ---
+    int rc = load_table_binary(new_table);
 
-    pthread_mutex_unlock(&global_list_lock);
+    pthread_mutex_lock(&stripe->lock);
+    new_table->loading = 0;
+    pthread_cond_broadcast(&stripe->changed);
+    if (rc == 0)
+    {
+        pthread_mutex_unlock(&stripe->lock);
+        return new_table;
+    }
+
+    // --- STEP F: Damaged snapshot: never serve (or checkpoint over) it ---
+    new_table->load_failed = 1;
+    *status = 503;
+    Table **link = link_of(bucket, new_table);
+    if (link == NULL)
+    {
+        // unload_table() unlinked it already and frees it once we let go
+        if (--new_table->refs == 0)
+            pthread_cond_broadcast(&stripe->changed);
+        pthread_mutex_unlock(&stripe->lock);
+        return NULL;
+    }
+    *link = new_table->next;
+    while (new_table->refs > 1)
+        pthread_cond_wait(&stripe->changed, &stripe->lock);
+    pthread_mutex_unlock(&stripe->lock);
+
+    destroy_table(new_table);
+    return NULL;
+}
+
+const char *table_error_text(int status)
+{
+    switch (status)
+    {
+    case 403:
+        return "Access Denied";
+    case 503:
+        return "Table data on disk is damaged";
+    default:
+        return "Server Memory Error";
+    }
+}
+
+void release_table(Table *t)
+{
+    TableStripe *stripe = stripe_of(bucket_of(t->id));
 
-    return new_table;
+    pthread_mutex_lock(&stripe->lock);
+    if (--t->refs == 0)
+        pthread_cond_broadcast(&stripe->changed);
+    pthread_mutex_unlock(&stripe->lock);
 }
 
 void unload_table(int table_id)
 {
-    pthread_mutex_lock(&global_list_lock);
-    Table *curr = global_tables_head;
-    Table *prev = NULL;
-    while (curr != NULL)
+    size_t bucket = bucket_of(table_id);
+    TableStripe *stripe = stripe_of(bucket);
+
+    pthread_mutex_lock(&stripe->lock);
+    Table **link = &table_buckets[bucket];
+    while (*link != NULL && (*link)->id != table_id)
+        link = &(*link)->next;
+
+    Table *curr = *link;
+    if (curr == NULL)
     {
-        if (curr->id == table_id)
+        pthread_mutex_unlock(&stripe->lock);
+        return;
+    }
+    *link = curr->next; // Unlink: nobody can look it up any more
+
+    // Wait for the requests that still hold it
+    while (curr->refs > 0)
+        pthread_cond_wait(&stripe->changed, &stripe->lock);
+    pthread_mutex_unlock(&stripe->lock);
+
+    destroy_table(curr);
+}
+
+void for_each_loaded_table(void (*visit)(Table *t, void *arg), void *arg)
+{
+    Table **pinned = NULL;
+    size_t capacity = 0;
+
+    for (size_t bucket = 0; bucket < TABLE_BUCKETS; bucket++)
+    {
+        // Only take references under the stripe: visit() may block on a table
+        // lock or on disk I/O, and lookups in the stripe must not wait for that
+        TableStripe *stripe = stripe_of(bucket);
+        size_t count = 0;
+        pthread_mutex_lock(&stripe->lock);
+        for (Table *t = table_buckets[bucket]; t != NULL; t = t->next)
         {
-            // Unlink from list
-            if (prev == NULL)
-                global_tables_head = curr->next;
-            else
-                prev->next = curr->next;
-
-            // Cleanup
-            emp *e_curr = curr->employeelist.head;
-            while (e_curr)
+            if (t->loading)
+                continue;
+            if (count == capacity)
             {
-                emp *n = e_curr->next;
-                free(e_curr);
-                e_curr = n;
+                size_t grown = capacity ? capacity * 2 : 16;
+                Table **larger = (Table **)realloc(pinned, grown * sizeof(Table *));
+                if (larger == NULL)
+                    break; // The rest of the bucket waits for the next call
+                pinned = larger;
+                capacity = grown;
             }
-            // Cleanup table resources
-            pthread_mutex_destroy(&curr->lock);
-            free(curr);
-            break;
+            t->refs++;
+            pinned[count++] = t;
+        }
+        pthread_mutex_unlock(&stripe->lock);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            visit(pinned[i], arg);
+            release_table(pinned[i]);
         }
-        prev = curr;
-        curr = curr->next;
     }
-    pthread_mutex_unlock(&global_list_lock);
-}
\ No newline at end of file
+    free(pinned);
+}
+
+Table *pick_cold_table(void)
+{
+    // Two turns of the hand: the first may only clear 'referenced' bits
+    for (size_t step = 0; step < 2 * TABLE_BUCKETS; step++)
+    {
+        size_t bucket = clock_hand;
+        clock_hand = (clock_hand + 1) % TABLE_BUCKETS;
+
+        TableStripe *stripe = stripe_of(bucket);
+        pthread_mutex_lock(&stripe->lock);
+        for (Table *t = table_buckets[bucket]; t != NULL; t = t->next)
+        {
+            if (t->refs > 0)
+                continue;
+            if (t->referenced)
+            {
+                t->referenced = 0; // Second chance
+                continue;
+            }
+            t->refs = 1;
+            pthread_mutex_unlock(&stripe->lock);
+            return t;
+        }
+        pthread_mutex_unlock(&stripe->lock);
+    }
+    return NULL;
+}
+
+int evict_table(Table *t)
+{
+    size_t bucket = bucket_of(t->id);
+    TableStripe *stripe = stripe_of(bucket);
+
+    pthread_mutex_lock(&stripe->lock);
+    Table **link = link_of(bucket, t);
+
+    // Someone else took it meanwhile, or it has writes the snapshot lacks
+    if (link == NULL || t->refs != 1 || t->dirty)
+    {
+        if (--t->refs == 0)
+            pthread_cond_broadcast(&stripe->changed);
+        pthread_mutex_unlock(&stripe->lock);
+        return -1;
+    }
+    *link = t->next;
+    t->refs = 0;
+    pthread_mutex_unlock(&stripe->lock);
+
+    destroy_table(t);
+    return 0;
+}
@@ -0,0 +1,296 @@
+// File_Name trigram.c
+// Trigram inverted index over name and department for substring search
+
+#include "trigram.h"
+
+#define ROW_KEYS_MAX 96             // 2 fields x (49 - 2) windows
+#define TRIGRAM_MIN_DEAD 4096       // Holes tolerated before the index is dropped
+
+void trigram_init(TrigramIndex *ti)
+{
+    memset(ti, 0, sizeof(*ti));
+}
+
+void trigram_free(TrigramIndex *ti)
+{
+    if (ti->postings != NULL)
+    {
+        for (size_t k = 0; k < TRIGRAM_KEYS; k++)
+            free(ti->postings[k].docs);
+        free(ti->postings);
+    }
+    free(ti->docs);
+    trigram_init(ti);
+}
+
+// Helper: map a byte to its alphabet slot
+static inline unsigned symbol(unsigned char ch)
+{
+    if (ch >= 'A' && ch <= 'Z')
+        ch = (unsigned char)(ch | 0x20);
+    if (ch >= 'a' && ch <= 'z')
+        return ch - 'a';
+    return ch == ' ' ? 26 : 27;
+}
+
+static int compare_keys(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Helper: append the trigram keys of one string
+static size_t push_keys(const char *text, size_t len, uint32_t *keys, size_t count)
+{
+    for (size_t i = 0; i + 2 < len; i++)
+    {
+        keys[count++] = (uint32_t)(symbol((unsigned char)text[i]) * TRIGRAM_ALPHABET * TRIGRAM_ALPHABET +
+                                   symbol((unsigned char)text[i + 1]) * TRIGRAM_ALPHABET +
+                                   symbol((unsigned char)text[i + 2]));
+    }
+    return count;
+}
+
+// Helper: sort and drop duplicates, returns the new count
+static size_t unique_keys(uint32_t *keys, size_t count)
+{
+    if (count < 2)
+        return count;
+
+    qsort(keys, count, sizeof(uint32_t), compare_keys);
+    size_t out = 1;
+    for (size_t i = 1; i < count; i++)
+    {
+        if (keys[i] != keys[out - 1])
+            keys[out++] = keys[i];
+    }
+    return out;
+}
+
+static int posting_push(Posting *p, uint32_t doc)
+{
+    if (p->len == p->capacity)
+    {
+        uint32_t capacity = p->capacity ? p->capacity * 2 : 4;
+        uint32_t *grown = (uint32_t *)realloc(p->docs, capacity * sizeof(uint32_t));
+        if (grown == NULL)
+            return -1;
+        p->docs = grown;
+        p->capacity = capacity;
+    }
+    p->docs[p->len++] = doc;
+    return 0;
+}
+
+// Helper: give a node the next doc number and post its trigrams
+static int index_node(TrigramIndex *ti, emp *node)
+{
+    if (ti->doc_count == ti->doc_capacity)
+    {
+        size_t capacity = ti->doc_capacity ? ti->doc_capacity * 2 : 1024;
+        emp **grown = (emp **)realloc(ti->docs, capacity * sizeof(emp *));
+        if (grown == NULL)
+            return -1;
+        ti->docs = grown;
+        ti->doc_capacity = capacity;
+    }
+
+    uint32_t doc = (uint32_t)ti->doc_count++;
+    ti->docs[doc] = node;
+    node->doc = doc;
+
+    uint32_t keys[ROW_KEYS_MAX];
+    size_t count = push_keys(node->name, strnlen(node->name, sizeof(node->name)), keys, 0);
+    count = push_keys(node->department, strnlen(node->department, sizeof(node->department)), keys, count);
+    count = unique_keys(keys, count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (posting_push(&ti->postings[keys[i]], doc) != 0)
+            return -1;
+    }
+    return 0;
+}
+
+int trigram_build(TrigramIndex *ti, const EmployeeList *list)
+{
+    trigram_free(ti);
+
+    ti->postings = (Posting *)calloc(TRIGRAM_KEYS, sizeof(Posting));
+    if (ti->postings == NULL)
+        return -1;
+
+    for (emp *curr = list->head; curr != NULL; curr = curr->next)
+    {
+        if (index_node(ti, curr) != 0)
+        {
+            trigram_free(ti);
+            return -1;
+        }
+    }
+
+    ti->order = TRIGRAM_IN_ORDER;
+    ti->built = 1;
+    return 0;
+}
+
+void trigram_add(TrigramIndex *ti, emp *node, int appended)
+{
+    if (!ti->built)
+        return;
+
+    if (index_node(ti, node) != 0)
+    {
+        // Half-posted row: drop the index, the next search rebuilds it
+        trigram_free(ti);
+        return;
+    }
+
+    // Only appends to an in-order index keep doc order == list order
+    if (!appended)
+        ti->order = TRIGRAM_UNORDERED;
+}
+
+void trigram_remove(TrigramIndex *ti, emp *node)
+{
+    if (!ti->built || node->doc >= ti->doc_count || ti->docs[node->doc] != node)
+        return;
+
+    ti->docs[node->doc] = NULL;
+    ti->dead++;
+
+    // Mostly holes: cheaper to rebuild on the next search than to keep filtering
+    if (ti->dead >= TRIGRAM_MIN_DEAD && ti->dead * 2 > ti->doc_count)
+        trigram_free(ti);
+}
+
+int trigram_usable(const SearchNeedle *n)
+{
+    return n->len >= 3 && n->numeric == NUMERIC_NONE;
+}
+
+// Helper: first index >= from whose doc is >= target
+static uint32_t seek(const Posting *p, uint32_t from, uint32_t target)
+{
+    uint32_t lo = from, hi = p->len;
+    while (lo < hi)
+    {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (p->docs[mid] < target)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+static int compare_posting_len(const void *a, const void *b)
+{
+    const Posting *x = *(const Posting *const *)a, *y = *(const Posting *const *)b;
+    return (x->len > y->len) - (x->len < y->len);
+}
+
+typedef struct {
+    size_t rank;            // Stored position
+    emp *node;
+} RankedMatch;
+
+static int compare_rank(const void *a, const void *b)
+{
+    size_t x = ((const RankedMatch *)a)->rank, y = ((const RankedMatch *)b)->rank;
+    return (x > y) - (x < y);
+}
+
+long trigram_search(TrigramIndex *ti, const EmployeeList *list, const SkipIndex *skip,
+                    const SearchNeedle *n, emp ***out)
+{
+    *out = NULL;
+
+    uint32_t keys[NEEDLE_MAX];
+    size_t key_count = unique_keys(keys, push_keys(n->lower, n->len, keys, 0));
+
+    // Intersect starting from the rarest trigram
+    const Posting *lists[NEEDLE_MAX];
+    uint32_t cursor[NEEDLE_MAX];
+    for (size_t i = 0; i < key_count; i++)
+    {
+        lists[i] = &ti->postings[keys[i]];
+        cursor[i] = 0;
+        if (lists[i]->len == 0)
+            return 0;
+    }
+    qsort(lists, key_count, sizeof(lists[0]), compare_posting_len);
+
+    size_t count = 0, capacity = 0;
+    emp **matches = NULL;
+
+    for (uint32_t i = 0; i < lists[0]->len; i++)
+    {
+        uint32_t doc = lists[0]->docs[i];
+        emp *node = ti->docs[doc];
+        if (node == NULL)
+            continue;
+
+        size_t k = 1;
+        for (; k < key_count; k++)
+        {
+            cursor[k] = seek(lists[k], cursor[k], doc);
+            if (cursor[k] == lists[k]->len || lists[k]->docs[cursor[k]] != doc)
+                break;
+        }
+        if (k < key_count)
+            continue;
+
+        // Trigrams only prove a candidate; confirm the actual substring
+        if (!needle_in_text(n, node->name, strnlen(node->name, sizeof(node->name))) &&
+            !needle_in_text(n, node->department, strnlen(node->department, sizeof(node->department))))
+            continue;
+
+        if (count == capacity)
+        {
+            capacity = capacity ? capacity * 2 : 64;
+            emp **grown = (emp **)realloc(matches, capacity * sizeof(emp *));
+            if (grown == NULL)
+            {
+                free(matches);
+                return -1;
+            }
+            matches = grown;
+        }
+        matches[count++] = node;
+    }
+
+    if (ti->order == TRIGRAM_UNORDERED && count > 1)
+    {
+        // Rank only the matches (O(m log n)) instead of walking the whole list
+        RankedMatch *ranked = (RankedMatch *)malloc(count * sizeof(RankedMatch));
+        if (ranked == NULL)
+        {
+            free(matches);
+            return -1;
+        }
+        for (size_t i = 0; i < count; i++)
+        {
+            ranked[i].rank = skip_rank(skip, matches[i]);
+            ranked[i].node = matches[i];
+        }
+        qsort(ranked, count, sizeof(RankedMatch), compare_rank);
+
+        for (size_t i = 0; i < count; i++)
+            matches[i] = ranked[list->reversed ? count - 1 - i : i].node;
+        free(ranked);
+    }
+    else if (list->reversed)
+    {
+        // Docs follow the stored order; a reversed list reads it backwards
+        for (size_t i = 0; i < count / 2; i++)
+        {
+            emp *tmp = matches[i];
+            matches[i] = matches[count - 1 - i];
+            matches[count - 1 - i] = tmp;
+        }
+    }
+
+    *out = matches;
+    return (long)count;
+}
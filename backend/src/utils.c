@@ -4,6 +4,8 @@
 #include "utils.h"
 #include "employee.h"
 #include "table.h"
+#include "search.h"
+#include "config.h"
 
 // ----HELPER: Validation Helper----
 bool isOnlyAlphaSpaces(const char *str)
@@ -30,42 +32,42 @@ int is_method(struct mg_http_message *hm, const char *method)
 
 // --- HELPER:  Core Validations logic ---
 const char *validate_core_logic(Table *t, int id, char *name, int age, char *dept, int salary)
+{
+    return validate_core_fields(t, id, isOnlyAlphaSpaces(name), strlen(name), isOnlyAlphaSpaces(dept), strlen(dept), age, salary);
+}
+
+// --- HELPER: Core validations on pre-scanned strings (same checks, same order) ---
+const char *validate_core_fields(Table *t, int id, bool name_alpha, size_t name_len, bool dept_alpha, size_t dept_len, int age, int salary)
 {
     if (t == NULL) return "System Error: Table not loaded.";
 
-    // Check Unique Id (Traverse the linked list of the CURRENT table)
-    int new_id = id;
-    emp *scanner = t->employeelist.head;
-    while (scanner != NULL)
+    // Check Unique Id (Hash lookup in the CURRENT table)
+    if (find_node_by_id(t, id) != NULL)
     {
-        if (scanner->id == new_id)
-        {
-            // ID FOUND! Return Error immediately.
-            return "Employee ID already exists";
-        }
-        scanner = scanner->next;
+        // ID FOUND! Return Error immediately.
+        return "Employee ID already exists";
     }
 
     // Check Name Format (Prevent special chars/scripts)
-    if (!isOnlyAlphaSpaces(name))
+    if (!name_alpha)
     {
         return "Name must contain only alphabets and spaces";
     }
 
     // Check for available charector size for Name (Buffer Overflow Prevention)
-    if (strlen(name) >= 50)
+    if (name_len >= 50)
     {
         return "Name is too long! Max 49 characters allowed.";
     }
 
     // Check Department Format (Prevent special chars/scripts)
-    if (!isOnlyAlphaSpaces(dept))
+    if (!dept_alpha)
     {
         return "Department field should only contain alphabet and spaces!";
     }
 
     // Check for available character size for Department (Buffer Overflow Prevention)
-    if (strlen(dept) >= 50)
+    if (dept_len >= 50)
     {
         return "Department is too long! Max 49 characters allowed.";
     }
@@ -86,102 +88,179 @@ const char *validate_core_logic(Table *t, int id, char *name, int age, char *dep
     return NULL;
 }
 
-// --- HELPER: Validations for new insertions using json ---
-const char *validate_employee_json(cJSON *j_data, Table *t)
+// --- HELPER: Validations for new insertions (parsed request body) ---
+const char *validate_employee_payload(const EmployeePayload *p, Table *t)
 {
-    if (!j_data)
+    if (p->data == FIELD_MISSING)
     {
         return "Missing 'data' object";
     }
 
-    // Extract Fields
-    cJSON *j_id = cJSON_GetObjectItem(j_data, "id");
-    cJSON *j_name = cJSON_GetObjectItem(j_data, "name");
-    cJSON *j_age = cJSON_GetObjectItem(j_data, "age");
-    cJSON *j_dept = cJSON_GetObjectItem(j_data, "department");
-    cJSON *j_salary = cJSON_GetObjectItem(j_data, "salary");
-
     // 1. Check Missing Fields
-    if (!j_id || !j_name || !j_age || !j_dept || !j_salary)
+    if (p->id.kind == FIELD_MISSING || p->name == FIELD_MISSING || p->age.kind == FIELD_MISSING ||
+        p->department == FIELD_MISSING || p->salary.kind == FIELD_MISSING)
     {
         return "All fields are required";
     }
 
     // 2. If Strings are actually strings
-    if (!cJSON_IsString(j_name) || !cJSON_IsString(j_dept))
+    if (p->name != FIELD_STRING || p->department != FIELD_STRING)
     {
         return "Name and Department must be String";
     }
 
     // 3. Check Numbers are actually numbers
-    if (!cJSON_IsNumber(j_id) || !cJSON_IsNumber(j_age) || !cJSON_IsNumber(j_salary))
+    if (p->id.kind != FIELD_NUMBER || p->age.kind != FIELD_NUMBER || p->salary.kind != FIELD_NUMBER)
     {
-
         return "ID, Age, and Salary must be numbers";
     }
 
-    // 4. Core validations
-    const char *error_msg = validate_core_logic(t, j_id->valueint, j_name->valuestring, j_age->valueint, j_dept->valuestring, j_salary->valueint);
-    if (error_msg != NULL)
+    // 4. Core validations ('NULL' if no error found)
+    return validate_core_fields(t, p->id.value, p->name_alpha, p->name_len, p->dept_alpha, p->dept_len,
+                                p->age.value, p->salary.value);
+}
+
+// --- HELPER: Read limit/cursor query parameters ---
+int parse_page_request(struct mg_http_message *hm, PageRequest *page)
+{
+    char limit_str[16], cursor_str[48];
+    memset(page, 0, sizeof(*page));
+
+    if (mg_http_get_var(&hm->query, "limit", limit_str, sizeof(limit_str)) > 0)
     {
-        return error_msg;
+        page->limit = atoi(limit_str);
+        if (page->limit <= 0)
+        {
+            return -1;
+        }
     }
 
-    // return 'NULL' if no error found
-    return NULL;
+    if (mg_http_get_var(&hm->query, "cursor", cursor_str, sizeof(cursor_str)) > 0)
+    {
+        if (page->limit == 0 || sscanf(cursor_str, "%d:%ld", &page->after_id, &page->served) != 2 || page->served < 0)
+        {
+            return -1;
+        }
+        page->has_cursor = 1;
+    }
+    return 0;
 }
 
-// --- HELPER: Case-Insensitive String Contains ---
-int str_contains_ci(const char *haystack, const char *needle){
-    if(!haystack || !needle){
+// --- HELPER: Read sort/order query parameters ---
+int parse_sort_request(struct mg_http_message *hm, SortKey *key)
+{
+    char sort_str[64], order_str[8];
+    memset(key, 0, sizeof(*key));
+
+    int sort_len = mg_http_get_var(&hm->query, "sort", sort_str, sizeof(sort_str));
+    if (sort_len == -4 || sort_len == -1)
+    {
+        return 0; // No sort: list order
+    }
+
+    int order_len = mg_http_get_var(&hm->query, "order", order_str, sizeof(order_str));
+    if (sort_len <= 0 || order_len == -3)
+    {
+        return -1; // Empty or too long
+    }
+    return sort_key_parse(sort_str, order_len > 0 ? order_str : NULL, key);
+}
+
+// --- HELPER: Conditional GET on the table version ---
+int table_etag_matches(Table *t, struct mg_http_message *hm, char *etag, size_t size)
+{
+    snprintf(etag, size, "\"%d-%08x-%llu\"", t->id, (unsigned)t->epoch, (unsigned long long)t->version);
+
+    struct mg_str *inm = mg_http_get_header(hm, "If-None-Match");
+    if (inm == NULL)
+    {
         return 0;
     }
-    // We create copies to avoid modifying the original data
-    char h_copy[100], n_copy[100];
 
-    // Copy and convert to Lowercase
-    strncpy(h_copy, haystack, 99); h_copy[99] = '\0';
-    strncpy(n_copy, needle, 99);   n_copy[99] = '\0';
+    // "*" or a list of (possibly weak, W/"...") tags: look for ours anywhere in it
+    size_t len = strlen(etag);
+    for (size_t i = 0; i < inm->len; i++)
+    {
+        if (inm->buf[i] == '*')
+            return 1;
+        if (i + len <= inm->len && memcmp(inm->buf + i, etag, len) == 0)
+            return 1;
+    }
+    return 0;
+}
 
-    for(int i = 0; h_copy[i]; i++) h_copy[i] = tolower((unsigned char)h_copy[i]);
-    for(int i = 0; n_copy[i]; i++) n_copy[i] = tolower((unsigned char)n_copy[i]);
+void reply_not_modified(struct mg_connection *c, const char *etag)
+{
+    mg_printf(c, "HTTP/1.1 304 Not Modified\r\n"
+                 "Access-Control-Allow-Origin: *\r\n"
+                 "ETag: %s\r\n"
+                 "Content-Length: 0\r\n\r\n", etag);
+}
 
-    // Use standard strstr on the lowercase versions
-    return (strstr(h_copy, n_copy) != NULL);
+// --- HELPER: Paged response envelope ---
+void page_stream_open(JsonStream *js, const PageRequest *page)
+{
+    json_stream_text(js, page->limit ? "{\"rows\":[" : "[");
 }
 
-// --- HELPER: Recurrsive Json creator ---
-void recursive_json_builder(emp *curr, cJSON *json_array)
+void page_stream_close(JsonStream *js, const PageRequest *page, int has_more, int last_id, long served,
+                       uint32_t epoch, uint64_t version)
 {
-    if (curr == NULL)
+    if (!page->limit)
     {
+        json_stream_text(js, "]");
         return;
     }
 
-    // 1. RECURSIVE CALL FIRST (Go to the end)
-    recursive_json_builder(curr->next, json_array);
+    char version_field[64];
+    snprintf(version_field, sizeof(version_field), "],\"epoch\":%u,\"version\":%llu", (unsigned)epoch,
+             (unsigned long long)version);
+    json_stream_text(js, version_field);
 
-    // 2. ADD TO JSON ON THE WAY BACK (Back-Tracking)
-    cJSON *emp_obj = cJSON_CreateObject();
-    cJSON_AddNumberToObject(emp_obj, "id", curr->id);
-    cJSON_AddStringToObject(emp_obj, "name", curr->name);
-    cJSON_AddNumberToObject(emp_obj, "age", curr->age);
-    cJSON_AddStringToObject(emp_obj, "department", curr->department);
-    cJSON_AddNumberToObject(emp_obj, "salary", curr->salary);
+    json_stream_text(js, ",\"next_cursor\":");
+    if (has_more)
+    {
+        char cursor[48];
+        snprintf(cursor, sizeof(cursor), "%d:%ld", last_id, served);
+        json_stream_string(js, cursor);
+    }
+    else
+    {
+        json_stream_text(js, "null");
+    }
+    json_stream_text(js, "}");
+}
+
+// --- HELPER: Case-Insensitive String Contains ---
+int str_contains_ci(const char *haystack, const char *needle){
+    if(!haystack || !needle){
+        return 0;
+    }
+    SearchNeedle prepared;
+    needle_prepare(&prepared, needle);
+    return needle_in_text(&prepared, haystack, strlen(haystack));
+}
 
-    // 3. ADD THE DATA OF EACH EMPLOYEE TO FULL TABLE
-    cJSON_AddItemToArray(json_array, emp_obj);
+// --- HELPER: Stream a row copy back to front ---
+void reverse_json_builder(const FrozenTable *rows, JsonStream *js)
+{
+    // A plain loop: constant stack whatever the table size
+    for (size_t i = rows->count; i > 0; i--)
+    {
+        const EmployeeRecord *r = &rows->rows[i - 1];
+        json_stream_row(js, r->id, r->name, r->age, r->department, r->salary);
+    }
 }
 
 // --- HELPER: To add to the specific list ---
-void append_to_list(Table *t, int id, char *name, int age, char *dept, int salary)
+emp *append_to_list(Table *t, int id, char *name, int age, char *dept, int salary)
 {
-    if(t == NULL) return;
+    if(t == NULL) return NULL;
 
-    emp *new_node = (emp *)calloc(1, sizeof(emp));
+    emp *new_node = node_alloc(&t->nodes);
     if (new_node == NULL)
     {
-        return;
+        return NULL;
     }
 
     // Set data
@@ -196,68 +275,344 @@ void append_to_list(Table *t, int id, char *name, int age, char *dept, int salar
     new_node->department[49] = '\0';
 
     new_node->salary = salary;
-    new_node->next = NULL;
 
     // Linking
-    if (t->employeelist.head == NULL)
+    insert_node_at_pos(t, new_node, -1);
+    return new_node;
+}
+
+// --- HELPER: To insert a node at a give position (For insert and update function) ---
+void insert_node_at_pos(Table *t, emp *insert, int position)
+{
+    if (t == NULL) return;
+
+    // Negative or past the tail = append; the skip list finds the spot in O(log n)
+    size_t count = t->skip.count;
+    size_t pos = (position < 0 || (size_t)position > count) ? count : (size_t)position;
+
+    // A reversed list is stored back to front: logical row pos sits before stored row count - pos
+    size_t stored = t->employeelist.reversed ? count - pos : pos;
+    int appended = (stored == count);
+    skip_insert(&t->skip, &t->employeelist, insert, stored);
+
+    id_index_put(&t->id_index, insert);
+    trigram_add(&t->trigrams, insert, appended);
+    range_index_add(&t->age_index, insert->age, insert->id);
+    range_index_add(&t->salary_index, insert->salary, insert->id);
+    agg_add(&t->dept_stats, insert);
+    table_mark_changed(t);
+    t->version++;
+    change_ring_record(&t->changes, t->version, CHANGE_INSERT, (int)pos, insert);
+
+    // Columnar copy takes appends and rows put back in place; anything else makes it stale
+    if (t->columns.valid && columns_insert(&t->columns, insert) != 0)
+        t->columns.valid = 0;
+}
+
+// --- HELPER: Find a node by ID (Hash lookup) ---
+emp *find_node_by_id(Table *t, int id)
+{
+    if (t == NULL) return NULL;
+
+    if (!t->id_index.broken)
     {
-        t->employeelist.head = new_node;
-        t->employeelist.tail = new_node;
+        return id_index_find(&t->id_index, id);
     }
-    else
+
+    // Index lost an allocation at some point: scan instead
+    for (emp *curr = t->employeelist.head; curr != NULL; curr = curr->next)
     {
-        t->employeelist.tail->next = new_node;
-        t->employeelist.tail = new_node;
+        if (curr->id == id)
+            return curr;
     }
+    return NULL;
 }
 
-// --- HELPER: To insert a node at a give position (For insert and update function) ---
-void insert_node_at_pos(Table *t, emp *insert, int position)
+// --- HELPER: Row at a logical position in O(log n) (NULL past the tail) ---
+emp *table_row_at(Table *t, size_t pos)
+{
+    if (t == NULL) return NULL;
+
+    size_t count = t->skip.count;
+    if (pos >= count) return NULL;
+    return skip_at(&t->skip, &t->employeelist, t->employeelist.reversed ? count - 1 - pos : pos);
+}
+
+// --- HELPER: Logical position of a node that is in the list ---
+size_t table_row_rank(Table *t, const emp *node)
+{
+    size_t stored = skip_rank(&t->skip, node);
+    return t->employeelist.reversed ? t->skip.count - 1 - stored : stored;
+}
+
+// --- HELPER: Unlink a known node in O(log n) ---
+void detach_node(Table *t, emp *node)
+{
+    if (t == NULL || node == NULL) return;
+
+    // Columnar copy only marks the row removed
+    if (t->columns.valid)
+        columns_remove(&t->columns, node);
+
+    skip_remove(&t->skip, &t->employeelist, node);
+
+    id_index_remove(&t->id_index, node->id);
+    trigram_remove(&t->trigrams, node);
+    range_index_remove(&t->age_index, node->age, node->id);
+    range_index_remove(&t->salary_index, node->salary, node->id);
+    agg_remove(&t->dept_stats, node);
+    table_mark_changed(t);
+    t->version++;
+    change_ring_record(&t->changes, t->version, CHANGE_DELETE, -1, node);
+}
+
+// --- HELPER: Unlink a node by ID (For delete, update and WAL replay) ---
+emp *detach_node_by_id(Table *t, int id)
+{
+    emp *node = find_node_by_id(t, id);
+    if (node != NULL)
+    {
+        detach_node(t, node);
+    }
+    return node;
+}
+
+// --- HELPER: Reverse the list in O(1) ---
+void reverse_list(Table *t)
 {
     if (t == NULL) return;
 
-    // Case 1: List is Empty
-    if (t->employeelist.head == NULL)
+    // Only the reading direction flips: the links, the skip list, the trigram
+    // docs and the columnar copy all stay valid in stored order
+    t->employeelist.reversed = !t->employeelist.reversed;
+    table_mark_changed(t);
+    t->version++;
+    change_ring_record(&t->changes, t->version, CHANGE_REVERSE, -1, NULL);
+}
+
+// --- HELPER: Columnar copy of the table, rebuilt if a mutation made it stale ---
+ColumnStore *table_columns(Table *t)
+{
+    if (t == NULL) return NULL;
+
+    // Readers share t->lock, so only one of them may build
+    pthread_mutex_lock(&t->build_lock);
+    int rc = 0;
+    if (!t->columns.valid)
     {
-        t->employeelist.head = insert;
-        t->employeelist.tail = insert;
+        rc = columns_build(&t->columns, &t->employeelist);
+        table_mark_changed(t);
     }
-    // Case 2: Insert at Head
-    else if (position == 0)
+    pthread_mutex_unlock(&t->build_lock);
+    return rc == 0 ? &t->columns : NULL;
+}
+
+// --- HELPER: Trigram index of the table, built on first use ---
+TrigramIndex *table_trigrams(Table *t)
+{
+    if (t == NULL || !server_config.trigram_index) return NULL;
+
+    pthread_mutex_lock(&t->build_lock);
+    int rc = 0;
+    if (!t->trigrams.built)
     {
-        insert->next = t->employeelist.head;
-        t->employeelist.head = insert;
+        rc = trigram_build(&t->trigrams, &t->employeelist);
+        table_mark_changed(t);
     }
-    // Case 3: Insert at Tail (Append)
-    else if (position == -1)
+    pthread_mutex_unlock(&t->build_lock);
+    return rc == 0 ? &t->trigrams : NULL; // NULL: caller scans instead
+}
+
+// --- HELPER: Sorted index on "age" or "salary", built on first use ---
+RangeIndex *table_range_index(Table *t, const char *field)
+{
+    if (t == NULL) return NULL;
+
+    int is_age = strcmp(field, "age") == 0;
+    if (!is_age && strcmp(field, "salary") != 0)
     {
-        t->employeelist.tail->next = insert;
-        t->employeelist.tail = insert;
+        return NULL;
     }
-    // Case 4: Insert at Specific Index (Middle)
-    else
+
+    RangeIndex *ri = is_age ? &t->age_index : &t->salary_index;
+    pthread_mutex_lock(&t->build_lock);
+    if (ri->built)
     {
-        emp *curr = t->employeelist.head;
-        emp *prev = NULL;
-        int curr_pos = 0;
+        pthread_mutex_unlock(&t->build_lock);
+        return ri;
+    }
 
-        while (curr != NULL && curr_pos < position)
-        {
-            prev = curr;
-            curr = curr->next;
-            curr_pos++;
-        }
+    RangeEntry *entries = (RangeEntry *)malloc((t->nodes.live + 1) * sizeof(RangeEntry));
+    if (entries == NULL)
+    {
+        pthread_mutex_unlock(&t->build_lock);
+        return NULL;
+    }
+
+    size_t count = 0;
+    for (emp *curr = t->employeelist.head; curr != NULL && count < t->nodes.live; curr = curr->next)
+    {
+        entries[count].key = is_age ? curr->age : curr->salary;
+        entries[count].id = curr->id;
+        count++;
+    }
+
+    int rc = range_index_build(ri, entries, count);
+    table_mark_changed(t);
+    pthread_mutex_unlock(&t->build_lock);
+    free(entries);
+    return rc == 0 ? ri : NULL;
+}
+
+// --- HELPER: Per-department aggregates, built on first use ---
+DeptAggregates *table_dept_stats(Table *t)
+{
+    if (t == NULL) return NULL;
+
+    pthread_mutex_lock(&t->build_lock);
+    int rc = 0;
+    if (!t->dept_stats.built)
+    {
+        rc = agg_build(&t->dept_stats, &t->employeelist);
+        table_mark_changed(t);
+    }
+    pthread_mutex_unlock(&t->build_lock);
+    return rc == 0 ? &t->dept_stats : NULL;
+}
 
-        // If position > list_length, append to end
-        if (curr == NULL)
+// --- HELPER: Row copy at the current version, shared by full-table readers ---
+FrozenTable *table_freeze(Table *t)
+{
+    if (t == NULL) return NULL;
+
+    pthread_mutex_lock(&t->build_lock);
+    if (t->frozen == NULL || t->frozen->version != t->version)
+    {
+        FrozenTable *fresh = frozen_build(&t->employeelist, t->skip.count, t->version);
+        if (fresh == NULL)
         {
-            t->employeelist.tail->next = insert;
-            t->employeelist.tail = insert;
+            pthread_mutex_unlock(&t->build_lock);
+            return NULL;
         }
-        else
+        frozen_release(t->frozen);
+        t->frozen = fresh;
+        table_mark_changed(t);
+    }
+    FrozenTable *f = t->frozen;
+    frozen_retain(f);
+    pthread_mutex_unlock(&t->build_lock);
+    return f;
+}
+
+// --- HELPER: Release a detached node ---
+void free_node(Table *t, emp *node)
+{
+    if (t == NULL || node == NULL) return;
+    skip_release(&t->skip, node);
+    node_release(&t->nodes, node);
+}
+
+// --- HELPER: Should the table's nodes be relaid out? ---
+int table_needs_compaction(Table *t)
+{
+    NodeAllocator *a = &t->nodes;
+    if (a->live == 0 || a->slab_count <= 1)
+        return 0;
+
+    // Holes worth a quarter of the rows, or the list has been reshuffled
+    // about once over since the last relayout
+    return (a->free_count >= SLAB_NODES && a->free_count * 4 >= a->live) ||
+           a->churn >= a->live + SLAB_NODES;
+}
+
+// --- HELPER: Relink the list into one contiguous slab, in list order ---
+int compact_table(Table *t)
+{
+    NodeAllocator fresh;
+    node_alloc_init(&fresh);
+
+    size_t count = t->nodes.live;
+    emp *block = node_alloc_block(&fresh, count);
+    if (block == NULL)
+    {
+        return -1; // Keep the old layout
+    }
+
+    size_t i = 0;
+    for (emp *curr = t->employeelist.head; curr != NULL && i < count; curr = curr->next, i++)
+    {
+        block[i] = *curr;
+        block[i].prev = (i > 0) ? &block[i - 1] : NULL;
+        block[i].next = (i + 1 < count) ? &block[i + 1] : NULL;
+    }
+
+    node_alloc_destroy(&t->nodes);
+    t->nodes = fresh;
+
+    t->employeelist.head = count ? &block[0] : NULL;
+    t->employeelist.tail = count ? &block[count - 1] : NULL;
+
+    // Every node moved: re-point the indexes (towers came along with the copies)
+    id_index_free(&t->id_index);
+    id_index_build(&t->id_index, t->employeelist.head);
+    skip_relink(&t->skip, &t->employeelist);
+
+    // Sort permutations point at the old nodes
+    sort_cache_free(&t->sorts);
+
+    // Renumber the trigram index in list order (dropped if that fails)
+    if (t->trigrams.built)
+    {
+        trigram_build(&t->trigrams, &t->employeelist);
+    }
+    return 0;
+}
+
+// --- HELPER: Something for the checkpointer to look at (cheap, any thread) ---
+void table_mark_changed(Table *t)
+{
+    atomic_store(&t->unflushed, 1);
+}
+
+// --- HELPER: Approximate heap bytes a loaded table holds (call while holding t->lock) ---
+size_t table_memory(Table *t)
+{
+    size_t bytes = sizeof(Table);
+
+    bytes += t->nodes.capacity * sizeof(emp);
+    bytes += t->skip.towers.bytes;
+    bytes += t->id_index.capacity * sizeof(IdSlot);
+
+    const ColumnStore *cs = &t->columns;
+    bytes += cs->row_capacity * (3 * sizeof(int) + 2 * sizeof(uint32_t) + 3 * sizeof(uint8_t)) + cs->text_capacity;
+
+    if (t->trigrams.built)
+    {
+        bytes += TRIGRAM_KEYS * sizeof(Posting) + t->trigrams.doc_capacity * sizeof(emp *);
+        for (size_t k = 0; k < TRIGRAM_KEYS; k++)
+            bytes += t->trigrams.postings[k].capacity * sizeof(uint32_t);
+    }
+
+    const RangeIndex *ranges[] = {&t->age_index, &t->salary_index};
+    for (int i = 0; i < 2; i++)
+        bytes += (ranges[i]->main_capacity + ranges[i]->pending_capacity + ranges[i]->removed_capacity) * sizeof(RangeEntry);
+
+    if (t->dept_stats.built)
+    {
+        bytes += t->dept_stats.capacity * sizeof(DeptStats);
+        for (size_t i = 0; i < t->dept_stats.capacity; i++)
         {
-            prev->next = insert;
-            insert->next = curr;
+            const RangeIndex *ri = &t->dept_stats.slots[i].salaries;
+            bytes += (ri->main_capacity + ri->pending_capacity + ri->removed_capacity) * sizeof(RangeEntry);
         }
     }
-}
\ No newline at end of file
+
+    for (int i = 0; i < SORT_CACHE_SLOTS; i++)
+        bytes += t->sorts.slots[i].count * sizeof(emp *);
+
+    if (t->frozen)
+        bytes += t->frozen->count * sizeof(EmployeeRecord);
+    if (t->changes.entries)
+        bytes += CHANGE_RING_SIZE * sizeof(Change);
+    return bytes;
+}
@@ -0,0 +1,253 @@
+// File_Name workers.c
+// Runs request handlers on a thread pool, off the mongoose event loop
+
+#include <pthread.h>
+
+#include "workers.h"
+
+typedef enum {
+    JOB_QUEUED,
+    JOB_RUNNING,
+    JOB_DONE,           // Reply captured, waiting for the event loop
+    JOB_ORPHANED        // Connection closed first; the worker frees the job
+} JobState;
+
+typedef struct WorkerJob {
+    struct WorkerJob *next;
+    unsigned long conn_id;
+    int state;                  // JobState, guarded by pool_lock
+    int close_after;            // Request said "Connection: close"
+    char *request;              // Private copy of the raw request
+    struct mg_http_message hm;  // Parsed view into 'request'
+    struct mg_connection out;   // Captures the handler's reply
+} WorkerJob;
+
+static struct mg_mgr *pool_mgr = NULL;
+static RequestHandler pool_handler = NULL;
+static pthread_t pool_threads[WORKERS_MAX];
+static int pool_size = 0;
+static int pool_running = 0;
+
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pool_wake = PTHREAD_COND_INITIALIZER;
+static WorkerJob *queue_head = NULL;
+static WorkerJob *queue_tail = NULL;
+
+// --- HELPER: the job attached to a connection (kept in c->data) ---
+static WorkerJob *job_of(struct mg_connection *c)
+{
+    WorkerJob *job;
+    memcpy(&job, c->data, sizeof(job));
+    return job;
+}
+
+static void attach_job(struct mg_connection *c, WorkerJob *job)
+{
+    memcpy(c->data, &job, sizeof(job));
+}
+
+static void free_job(WorkerJob *job)
+{
+    mg_iobuf_free(&job->out.send);
+    free(job->request);
+    free(job);
+}
+
+// Helper: point a slice of the original message at the same bytes of the copy
+static void rebase(struct mg_str *s, const struct mg_str *message, char *copy)
+{
+    if (s->buf >= message->buf && s->buf <= message->buf + message->len)
+        s->buf = copy + (s->buf - message->buf);
+}
+
+static void *worker_main(void *arg)
+{
+    (void)arg;
+
+    pthread_mutex_lock(&pool_lock);
+    while (1)
+    {
+        while (queue_head == NULL && pool_running)
+            pthread_cond_wait(&pool_wake, &pool_lock);
+
+        // Stopping still drains the queue: those requests were accepted
+        WorkerJob *job = queue_head;
+        if (job == NULL)
+            break;
+        queue_head = job->next;
+        if (queue_head == NULL)
+            queue_tail = NULL;
+        if (job->state == JOB_QUEUED)
+            job->state = JOB_RUNNING;
+        pthread_mutex_unlock(&pool_lock);
+
+        pool_handler(&job->out, &job->hm);
+
+        pthread_mutex_lock(&pool_lock);
+        if (job->state == JOB_ORPHANED)
+        {
+            free_job(job);
+            continue;
+        }
+        job->state = JOB_DONE;
+        unsigned long conn_id = job->conn_id;
+        pthread_mutex_unlock(&pool_lock);
+
+        // Only the id travels; the event loop picks the reply up from c->data
+        mg_wakeup(pool_mgr, conn_id, "", 0);
+
+        pthread_mutex_lock(&pool_lock);
+    }
+    pthread_mutex_unlock(&pool_lock);
+    return NULL;
+}
+
+int start_workers(struct mg_mgr *mgr, int count, RequestHandler handler)
+{
+    if (count <= 0)
+        return -1;
+    if (count > WORKERS_MAX)
+        count = WORKERS_MAX;
+
+    if (!mg_wakeup_init(mgr))
+    {
+        printf("[WORKERS] Wakeup pipe unavailable, serving requests inline.\n");
+        return -1;
+    }
+
+    pool_mgr = mgr;
+    pool_handler = handler;
+    pool_running = 1;
+    for (pool_size = 0; pool_size < count; pool_size++)
+    {
+        if (pthread_create(&pool_threads[pool_size], NULL, worker_main, NULL) != 0)
+            break;
+    }
+
+    if (pool_size == 0)
+    {
+        pool_running = 0;
+        perror("Failed to start workers");
+        return -1;
+    }
+    printf("[WORKERS] %d worker threads started.\n", pool_size);
+    return 0;
+}
+
+void stop_workers(void)
+{
+    pthread_mutex_lock(&pool_lock);
+    pool_running = 0;
+    pthread_cond_broadcast(&pool_wake);
+    pthread_mutex_unlock(&pool_lock);
+
+    for (int i = 0; i < pool_size; i++)
+        pthread_join(pool_threads[i], NULL);
+    pool_size = 0;
+}
+
+int workers_submit(struct mg_connection *c, struct mg_http_message *hm)
+{
+    if (pool_size == 0)
+        return -1;
+
+    WorkerJob *job = (WorkerJob *)calloc(1, sizeof(WorkerJob));
+    char *copy = (char *)malloc(hm->message.len + 1);
+    if (job == NULL || copy == NULL)
+    {
+        free(job);
+        free(copy);
+        return -1;
+    }
+
+    // mongoose drops the request from c->recv once this event returns
+    memcpy(copy, hm->message.buf, hm->message.len);
+    copy[hm->message.len] = '\0';
+
+    job->hm = *hm;
+    rebase(&job->hm.method, &hm->message, copy);
+    rebase(&job->hm.uri, &hm->message, copy);
+    rebase(&job->hm.query, &hm->message, copy);
+    rebase(&job->hm.proto, &hm->message, copy);
+    for (int i = 0; i < MG_MAX_HTTP_HEADERS; i++)
+    {
+        rebase(&job->hm.headers[i].name, &hm->message, copy);
+        rebase(&job->hm.headers[i].value, &hm->message, copy);
+    }
+    rebase(&job->hm.body, &hm->message, copy);
+    rebase(&job->hm.head, &hm->message, copy);
+    rebase(&job->hm.message, &hm->message, copy);
+
+    struct mg_str *connection = mg_http_get_header(hm, "Connection");
+    job->close_after = connection != NULL && mg_strcasecmp(*connection, mg_str("close")) == 0;
+    job->conn_id = c->id;
+    job->request = copy;
+    job->out.send.align = MG_IO_SIZE;
+    job->state = JOB_QUEUED;
+
+    // c->is_resp stays set until the reply is delivered
+    attach_job(c, job);
+
+    pthread_mutex_lock(&pool_lock);
+    if (queue_tail != NULL)
+        queue_tail->next = job;
+    else
+        queue_head = job;
+    queue_tail = job;
+    pthread_cond_signal(&pool_wake);
+    pthread_mutex_unlock(&pool_lock);
+    return 0;
+}
+
+// Helper: move a finished reply onto the connection
+static void deliver(struct mg_connection *c, WorkerJob *job)
+{
+    if (c->send.len == 0)
+    {
+        // Nothing queued ahead of it: take the buffer instead of copying
+        mg_iobuf_free(&c->send);
+        c->send = job->out.send;
+        memset(&job->out.send, 0, sizeof(job->out.send));
+    }
+    else if (!mg_send(c, job->out.send.buf, job->out.send.len))
+    {
+        c->is_closing = 1;
+    }
+
+    if (job->out.is_draining || job->close_after)
+        c->is_draining = 1;
+    if (job->out.is_closing)
+        c->is_closing = 1;
+    c->is_resp = 0;
+}
+
+void workers_event(struct mg_connection *c, int ev)
+{
+    WorkerJob *job = job_of(c);
+    if (job == NULL)
+        return;
+
+    pthread_mutex_lock(&pool_lock);
+    if (ev == MG_EV_CLOSE)
+    {
+        attach_job(c, NULL);
+        if (job->state == JOB_DONE)
+            free_job(job);
+        else
+            job->state = JOB_ORPHANED;
+        pthread_mutex_unlock(&pool_lock);
+        return;
+    }
+
+    // MG_EV_POLL also checks, in case a wakeup datagram was dropped
+    if (job->state != JOB_DONE)
+    {
+        pthread_mutex_unlock(&pool_lock);
+        return;
+    }
+    pthread_mutex_unlock(&pool_lock);
+
+    attach_job(c, NULL);
+    deliver(c, job);
+    free_job(job);
+}
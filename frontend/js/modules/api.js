@@ -38,12 +38,64 @@ export const Api = {
     return res.ok ? await res.json() : [];
   },
 
+  // --- READ ONE PAGE ({ rows, next_cursor }; pass next_cursor back for the next page) ---
+  // sort: optional { field: "salary" or "age,name", order: "asc" | "desc" }
+  async getPage(tableId, limit, cursor, sort) {
+    const params = new URLSearchParams({ table_id: tableId, limit });
+    if (cursor) params.set("cursor", cursor);
+    if (sort) {
+      params.set("sort", sort.field);
+      params.set("order", sort.order);
+    }
+    const res = await http(`${BASE}/show?${params}`);
+    return res.ok ? await res.json() : { rows: [], next_cursor: null };
+  },
+
   // --- Search Employee ---
   async search(queryText, tableId) {
     const res = await http(`${BASE}/search?query=${encodeURIComponent(queryText)}&table_id=${tableId}`);
     return res.ok ? await res.json() : [];
   },
 
+  // --- Search Employee, one page at a time ---
+  async searchPage(queryText, tableId, limit, cursor) {
+    const params = new URLSearchParams({ query: queryText, table_id: tableId, limit });
+    if (cursor) params.set("cursor", cursor);
+    const res = await http(`${BASE}/search?${params}`);
+    return res.ok ? await res.json() : { rows: [], next_cursor: null };
+  },
+
+  // --- Structured filter, e.g. department = "Sales" AND salary > 50000 (one page) ---
+  async filterPage(expression, tableId, limit, cursor) {
+    const params = new URLSearchParams({ filter: expression, table_id: tableId, limit });
+    if (cursor) params.set("cursor", cursor);
+    const res = await http(`${BASE}/search?${params}`);
+    if (res.ok) return await res.json();
+    const err = await res.json().catch(() => ({}));
+    return { rows: [], next_cursor: null, error: err.error || "Filter Failed" };
+  },
+
+  // --- Range Query on age / salary (either bound may be null) ---
+  async range(field, min, max, tableId) {
+    const params = new URLSearchParams({ table_id: tableId, field });
+    if (min !== null && min !== undefined) params.set("min", min);
+    if (max !== null && max !== undefined) params.set("max", max);
+    const res = await http(`${BASE}/range?${params}`);
+    return res.ok ? await res.json() : [];
+  },
+
+  // --- Per-department headcount / salary / age statistics ---
+  async aggregates(tableId) {
+    const res = await http(`${BASE}/aggregates?table_id=${tableId}`);
+    return res.ok ? await res.json() : [];
+  },
+
+  // --- Changes since a listing's version (null if unreachable) ---
+  async changes(tableId, epoch, since) {
+    const res = await http(`${BASE}/changes?table_id=${tableId}&epoch=${epoch}&since=${since}`);
+    return res.ok ? await res.json() : null;
+  },
+
   // --- Insert Employee Details ---
   async insert(payload) {
     return await http(`${BASE}/insert`, {
@@ -60,6 +112,14 @@ export const Api = {
     });
   },
 
+  // --- Apply many insert / update / delete ops at once (all or nothing) ---
+  async batch(tableId, ops) {
+    return await http(`${BASE}/batch`, {
+      method: "POST",
+      body: JSON.stringify({ table_id: tableId, ops }),
+    });
+  },
+
   // --- Delete Employee Details ---
   async delete(id, tableId) {
     return await http(`${BASE}/delete?id=${id}&table_id=${tableId}`, {
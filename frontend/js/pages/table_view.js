@@ -25,6 +25,21 @@ if (titleEl && TABLE_NAME) titleEl.textContent = TABLE_NAME;
 // State for Toggle View
 let isRecursiveView = false;
 
+// Rows fetched per request; later pages are appended as they arrive
+const PAGE_SIZE = 500;
+// Bumped on every new listing so a stale page loop stops appending
+let listingToken = 0;
+
+// Rows of the full standard listing and the table version they reflect
+// (versions only compare within the epoch the server reported with them);
+// syncVersion is null whenever the view can't be patched with /changes
+let shownRows = [];
+let syncVersion = null;
+let syncEpoch = null;
+
+// Column the standard listing is sorted by on the server ({ field, order }), null = list order
+let sortState = null;
+
 // --- 3. PAGE LOAD HANDLER ---
 document.addEventListener("DOMContentLoaded", () => {
   // Only fetch Navbar if we have a place to put it
@@ -311,21 +326,103 @@ async function performUpdate() {
 // --- TABLE FUNCTIONS ---
 window.loadStandardTable = async function () {
   try {
-    // 1. Fetch & Parse (Handled by Api + http.js)
-    const data = await Api.getAll(TABLE_ID);
-    // 2. Render
-    renderTable(data);
+    // 1. Fetch page by page: the first one paints right away
+    // (a sorted listing can't be patched by position, so it isn't tracked)
+    await loadPaged(
+      (cursor) => Api.getPage(TABLE_ID, PAGE_SIZE, cursor, sortState),
+      !sortState,
+    );
   } catch (error) {
     console.error("Load Table Error:", error);
   }
 };
 
+// Render the first page, then keep appending until the cursor runs out
+async function loadPaged(fetchPage, trackVersion = false) {
+  const token = ++listingToken;
+  syncVersion = null;
+  let page = await fetchPage(null);
+  if (token !== listingToken) return;
+  renderTable(page.rows);
+
+  const rows = [...page.rows];
+  while (page.next_cursor) {
+    const { epoch, version } = page;
+    page = await fetchPage(page.next_cursor);
+    if (token !== listingToken) return;
+    appendRows(page.rows, rows.length);
+    rows.push(...page.rows);
+    // Pages of different versions don't add up to one state of the table
+    if (page.epoch !== epoch || page.version !== version) trackVersion = false;
+  }
+
+  if (trackVersion) {
+    shownRows = rows;
+    syncVersion = page.version;
+    syncEpoch = page.epoch;
+  }
+}
+
+// Patch the standard listing with what changed since it was fetched;
+// falls back to a full reload when the server can't say
+async function syncStandardTable() {
+  if (isRecursiveView || syncVersion === null)
+    return window.loadStandardTable();
+
+  const token = ++listingToken;
+  const delta = await Api.changes(TABLE_ID, syncEpoch, syncVersion);
+  if (token !== listingToken) return;
+  if (!delta || delta.full_resync) return window.loadStandardTable();
+
+  for (const change of delta.changes) {
+    if (change.op === "insert") {
+      shownRows = shownRows.filter((emp) => emp.id !== change.row.id);
+      shownRows.splice(change.position, 0, change.row);
+    } else if (change.op === "delete") {
+      shownRows = shownRows.filter((emp) => emp.id !== change.id);
+    } else if (change.op === "reverse") {
+      shownRows.reverse();
+    }
+  }
+  syncVersion = delta.version;
+  syncEpoch = delta.epoch;
+  renderTable(shownRows);
+}
+
+// Header sort icons: ascending, then descending, then back to list order
+window.sortBy = function (field) {
+  if (!sortState || sortState.field !== field)
+    sortState = { field, order: "asc" };
+  else if (sortState.order === "asc") sortState.order = "desc";
+  else sortState = null;
+
+  document.querySelectorAll("[id^='sort_']").forEach((icon) => {
+    const active = sortState && icon.id === `sort_${sortState.field}`;
+    icon.className = `fa-solid ${
+      active ? (sortState.order === "asc" ? "fa-sort-up" : "fa-sort-down") : "fa-sort"
+    }`;
+  });
+
+  // The recursive view shows the list backwards, not a sort
+  if (isRecursiveView) window.recursiveReverse();
+  else window.loadStandardTable();
+};
+
 window.searchData = async function () {
   const query = document.getElementById("searchId").value.trim();
   if (!query) return alert("Please enter a Name, ID or Department");
+
+  // Names and departments are letters only, so an operator means a filter
+  const isFilter = /[<>=]|\bcontains\b/i.test(query);
+  const fetchPage = isFilter
+    ? async (cursor) => {
+        const page = await Api.filterPage(query, TABLE_ID, PAGE_SIZE, cursor);
+        if (page.error) alert(page.error);
+        return page;
+      }
+    : (cursor) => Api.searchPage(query, TABLE_ID, PAGE_SIZE, cursor);
   try {
-    const data = await Api.search(query, TABLE_ID);
-    renderTable(data);
+    await loadPaged(fetchPage);
   } catch (error) {
     console.error(error);
   }
@@ -335,9 +432,9 @@ window.deleteEmp = async function (id) {
   if (!confirm("Delete ID " + id + "?")) return;
   try {
     const response = await Api.delete(id, TABLE_ID);
-    // If recursive view is active, reload it. Otherwise, reload standard table.
+    // If recursive view is active, reload it. Otherwise, patch the standard table.
     if (response.ok)
-      isRecursiveView ? window.recursiveReverse() : window.loadStandardTable();
+      isRecursiveView ? window.recursiveReverse() : syncStandardTable();
   } catch (error) {
     console.error(error);
   }
@@ -347,7 +444,7 @@ window.linkedReverse = async function () {
   isRecursiveView = false; // Reset toggle
   try {
     const response = await Api.reverse(TABLE_ID);
-    if (response.ok) window.loadStandardTable();
+    if (response.ok) syncStandardTable();
   } catch (error) {
     console.error(error);
   }
@@ -366,6 +463,8 @@ window.recursiveReverse = async function () {
 
   if (!isRecursiveView) return window.loadStandardTable();
 
+  listingToken++; // Stop any paged listing still appending
+  syncVersion = null;
   try {
     const data = await Api.recursiveReverse(TABLE_ID);
     renderTable(data);
@@ -417,7 +516,7 @@ window.send_file_to_backend = async function () {
       if (response.ok) {
         const res = await response.json();
         alert(`Added: ${res.added}, Skipped: ${res.skipped}`);
-        window.loadStandardTable();
+        syncStandardTable();
       } else alert("Upload Failed");
     } catch (err) {
       console.error(err);
@@ -460,11 +559,26 @@ function renderTable(data) {
   }
 
   const list = Array.isArray(data) ? data : [data];
-  list.forEach((emp, index) => {
-    // Dynamic SN calculation based on View Mode
-    let sn = isRecursiveView ? list.length - index : index + 1;
+  tbody.innerHTML = list
+    .map((emp, index) =>
+      // Dynamic SN calculation based on View Mode
+      rowHtml(emp, index, isRecursiveView ? list.length - index : index + 1),
+    )
+    .join("");
+}
+
+// Add the next page of a paged listing under the rows already shown
+function appendRows(rows, offset) {
+  const tbody = document.getElementById("tableBody");
+  if (!tbody || !rows.length) return;
+  tbody.insertAdjacentHTML(
+    "beforeend",
+    rows.map((emp, i) => rowHtml(emp, offset + i, offset + i + 1)).join(""),
+  );
+}
 
-    const row = `<tr>
+function rowHtml(emp, index, sn) {
+  return `<tr>
             <td>${sn}</td>
             <td>${emp.name}</td>
             <td>${emp.id}</td>
@@ -476,6 +590,4 @@ function renderTable(data) {
                 <a class="btn btn-dark btn-sm" href="update_emp.html?id=${emp.id}&pos=${index}&table_id=${TABLE_ID}&name=${encodeURIComponent(TABLE_NAME || "")}">Update</a>
             </td>
         </tr>`;
-    tbody.innerHTML += row;
-  });
 }
@@ -13,7 +13,7 @@ const C_BACKEND = process.env.BACKEND_URL || "http://localhost:8000";
 
 // --- MIDDLEWARE ---
 app.use(cors());
-app.use(express.json()); // PARSE EVERYTHING (We are no longer streaming blindly)
+app.use(express.json({ limit: "3mb" })); // PARSE EVERYTHING (We are no longer streaming blindly). 3mb = the C server's receive limit, room for /batch bodies
 app.use(express.text({ limit: "50mb" }));
 
 // --- HELPER: Centralized C-Backend Caller ---
@@ -24,6 +24,7 @@ async function callC(
   payload = {},
   params = {},
   tokenData = null,
+  headers = {},
 ) {
   try {
     // --- DEBUG LOGS (Add these lines) ---
@@ -51,9 +52,15 @@ async function callC(
       url: `${C_BACKEND}${endpoint}`,
       data: payload,
       params: params,
+      headers: headers,
+      validateStatus: (status) => status < 300 || status === 304,
     });
 
-    return { status: response.status, data: response.data };
+    return {
+      status: response.status,
+      data: response.data,
+      etag: response.headers.etag,
+    };
   } catch (error) {
     // Handle C Server Errors
     if (error.response) {
@@ -64,6 +71,20 @@ async function callC(
   }
 }
 
+// --- HELPER: Conditional GET pass-through ---
+// The C server answers If-None-Match with a bodiless 304 when the table's
+// version still matches, so forward the header and relay ETag / 304 back.
+function conditionalHeaders(req) {
+  const tag = req.headers["if-none-match"];
+  return tag ? { "If-None-Match": tag } : {};
+}
+
+function sendVersioned(res, result) {
+  if (result.etag) res.setHeader("ETag", result.etag);
+  if (result.status === 304) return res.status(304).end();
+  res.status(result.status).json(result.data);
+}
+
 // ==========================
 // 1. AUTHENTICATION ROUTES
 // ==========================
@@ -183,14 +204,35 @@ app.post("/insert", async (req, res) => {
 // SHOW ALL (GET)
 app.get("/show", async (req, res) => {
   // Query: ?table_id=1001
-  const result = await callC("GET", "/show", {}, req.query, req.user);
-  res.status(result.status).json(result.data);
+  const result = await callC("GET", "/show", {}, req.query, req.user, conditionalHeaders(req));
+  sendVersioned(res, result);
 });
 
 // SEARCH (GET)
 app.get("/search", async (req, res) => {
   // Query: ?table_id=1001&id=5
-  const result = await callC("GET", "/search", {}, req.query, req.user);
+  const result = await callC("GET", "/search", {}, req.query, req.user, conditionalHeaders(req));
+  sendVersioned(res, result);
+});
+
+// RANGE QUERY (GET)
+app.get("/range", async (req, res) => {
+  // Query: ?table_id=1001&field=salary&min=50000&max=80000
+  const result = await callC("GET", "/range", {}, req.query, req.user);
+  res.status(result.status).json(result.data);
+});
+
+// DEPARTMENT AGGREGATES (GET)
+app.get("/aggregates", async (req, res) => {
+  // Query: ?table_id=1001
+  const result = await callC("GET", "/aggregates", {}, req.query, req.user);
+  res.status(result.status).json(result.data);
+});
+
+// CHANGES SINCE A VERSION (GET)
+app.get("/changes", async (req, res) => {
+  // Query: ?table_id=1001&epoch=2882400001&since=42
+  const result = await callC("GET", "/changes", {}, req.query, req.user);
   res.status(result.status).json(result.data);
 });
 
@@ -208,6 +250,14 @@ app.put("/update", async (req, res) => {
   res.status(result.status).json(result.data);
 });
 
+// BATCH (POST)
+app.post("/batch", async (req, res) => {
+  // Body: { table_id, ops: [{ op: "insert" | "update" | "delete", ... }] }
+  // All ops apply or none do; the reply has one result per op
+  const result = await callC("POST", "/batch", req.body, {}, req.user);
+  res.status(result.status).json(result.data);
+});
+
 // ==========================
 // 5. UTILITIES (Reverse, Export)
 // ==========================
@@ -224,8 +274,9 @@ app.get("/recursivereverse", async (req, res) => {
     {},
     req.query,
     req.user,
+    conditionalHeaders(req),
   );
-  res.status(result.status).json(result.data);
+  sendVersioned(res, result);
 });
 
 app.post("/upload_csv", async (req, res) => {
@@ -248,9 +299,14 @@ app.get("/download_table", async (req, res) => {
       method: "GET",
       url: `${C_BACKEND}/download_table`,
       params: { ...req.query, owner_id: req.user.id },
+      headers: conditionalHeaders(req),
       responseType: "stream", // Important for file downloads
+      validateStatus: (status) => status === 200 || status === 304,
     });
 
+    if (response.headers.etag) res.setHeader("ETag", response.headers.etag);
+    if (response.status === 304) return res.status(304).end();
+
     // Pipe the file stream directly to the client
     res.setHeader("Content-Type", "text/csv");
     res.setHeader(